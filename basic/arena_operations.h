@@ -0,0 +1,149 @@
+/*
+ * Header including the arena that holds every board created
+ * by 8-tile. Boards are stored in fixed size chunks, so they
+ * never move once created, and are addressed by their index
+ * (place in the queue), giving O(1) access to any board.
+ */
+#include <stdlib.h>
+#include "board_operations.h"
+
+#define ARENA_MEMORY_ERROR "\nERROR: Unable to allocate " \
+"space for new boards.\n\n"
+
+/* Each chunk holds 2^12 = 4096 boards. */
+#define CHUNK_SHIFT 12
+#define CHUNK_SIZE (1 << CHUNK_SHIFT)
+#define CHUNK_MASK (CHUNK_SIZE - 1)
+
+/* Initial number of chunks the arena has room for. */
+#define CHUNKS_START 16
+
+/* Board at index i of the arena. */
+#define NODE(arena, i) \
+(&(arena)->chunk[(i) >> CHUNK_SHIFT][(i) & CHUNK_MASK])
+
+/* Puzzle: data structure used throughout program. */
+struct puzzle{
+  Packed board ;
+  int parent ;
+  int blank ;
+  int last_blank ;
+} ;
+typedef struct puzzle Puzzle ;
+
+/* Arena: every board, in the order they were created. */
+struct arena{
+  Puzzle **chunk ;
+  int chunks ;
+  int size ;
+  int count ;
+} ;
+typedef struct arena Arena ;
+
+/* Search_Stats: counts kept by the search, for the user. */
+struct search_stats{
+  long expanded ;
+  long generated ;
+  long pruned ;
+} ;
+typedef struct search_stats Search_Stats ;
+
+void create_arena(Arena *arena) ;
+int new_board(Arena *arena) ;
+int reserve_boards(Arena *arena, int boards) ;
+void add_chunk(Arena *arena) ;
+void free_arena(Arena *arena) ;
+
+
+/* Arena starts empty, with room for the chunk pointers. */
+void create_arena(Arena *arena)
+{
+  arena->chunk = (Puzzle **)malloc(CHUNKS_START * \
+  sizeof(Puzzle *)) ;
+
+  if(arena->chunk == NULL){
+    fprintf(stderr, ARENA_MEMORY_ERROR) ;
+    exit(EXIT_FAILURE) ;
+  }
+
+  arena->chunks = 0 ;
+  arena->size = CHUNKS_START ;
+  arena->count = 0 ;
+
+  return ;
+}
+
+/* Reserves space for one more board, returns its index. */
+int new_board(Arena *arena)
+{
+  /* Only need a new chunk when the last one is full. */
+  if(arena->count == (arena->chunks << CHUNK_SHIFT)){
+    add_chunk(arena) ;
+  }
+
+  return arena->count++ ;
+}
+
+/*
+ * Reserves space for a number of boards at once (eg a whole
+ * layer of the parallel search), returns the first index.
+ */
+int reserve_boards(Arena *arena, int boards)
+{
+  int first ;
+
+  first = arena->count ;
+
+  while((arena->chunks << CHUNK_SHIFT) < first + boards){
+    add_chunk(arena) ;
+  }
+
+  arena->count += boards ;
+
+  return first ;
+}
+
+/* Adds one more chunk, doubling the chunk pointers if full.*/
+void add_chunk(Arena *arena)
+{
+  if(arena->chunks == arena->size){
+    arena->size *= 2 ;
+
+    arena->chunk = (Puzzle **)realloc(arena->chunk, \
+    arena->size * sizeof(Puzzle *)) ;
+
+    if(arena->chunk == NULL){
+      fprintf(stderr, ARENA_MEMORY_ERROR) ;
+      exit(EXIT_FAILURE) ;
+    }
+  }
+
+  arena->chunk[arena->chunks] = (Puzzle *)malloc( \
+  CHUNK_SIZE * sizeof(Puzzle)) ;
+
+  if(arena->chunk[arena->chunks] == NULL){
+    fprintf(stderr, ARENA_MEMORY_ERROR) ;
+    exit(EXIT_FAILURE) ;
+  }
+
+  arena->chunks++ ;
+
+  return ;
+}
+
+/* Releases every board at once, chunk by chunk. */
+void free_arena(Arena *arena)
+{
+  int i ;
+
+  for(i = 0 ; i < arena->chunks ; i++){
+    free(arena->chunk[i]) ;
+  }
+
+  free(arena->chunk) ;
+
+  arena->chunk = NULL ;
+  arena->chunks = arena->size = arena->count = 0 ;
+
+  return ;
+}
@@ -0,0 +1,80 @@
+/*
+ * Header including the packed board used by the solver of
+ * 8-tile. Each cell is stored in 4 bits of a 64-bit word,
+ * cell 0 (top left) in the lowest 4 bits, so a board fits in
+ * a single integer and two boards are equal iff the words
+ * are. Boards are only converted to/from char[YS][XS] when
+ * read from file and when displayed.
+ */
+#include <stdint.h>
+
+/* Packed: 4 bits per cell, ie up to 16 cells per board. */
+typedef uint64_t Packed ;
+
+#define CELL_BITS 4
+#define CELL_MASK ((Packed)0xF)
+
+/*
+ * Code stored in each cell is the cell that the tile is in
+ * at the solution. Tiles '1' to '8' are 0 to 7 and the blank
+ * is 8, so the solution has code i in every cell i.
+ */
+#define BLANK_CODE NUM_WO_BLANK
+#define TILE_CODE(c) ((c == BLANK) ? BLANK_CODE : (c - '1'))
+#define CODE_TILE(v) ((v == BLANK_CODE) ? BLANK : (v + '1'))
+
+/* Packed solution, ie 0x876543210. */
+#define PACKED_SOLUTION ((Packed)0x87654321 << CELL_BITS)
+
+/* Code of the tile in cell i of a packed board. */
+#define CELL(board, i) \
+((int)((board >> ((i) * CELL_BITS)) & CELL_MASK))
+
+Packed pack_board(char *top_left) ;
+void unpack_board(Packed board, char *top_left) ;
+Packed slide_tile(Packed board, int tile, int blank) ;
+
+
+/* Packs a char board (from file) into a single word. */
+Packed pack_board(char *top_left)
+{
+  Packed board ;
+  int i ;
+
+  board = 0 ;
+
+  for(i = 0 ; i < NUM_TILES ; i++){
+    board |= (Packed)TILE_CODE(*(top_left + i)) << \
+    (i * CELL_BITS) ;
+  }
+
+  return board ;
+}
+
+/* Unpacks a board into char form, ready to be displayed. */
+void unpack_board(Packed board, char *top_left)
+{
+  int i, code ;
+
+  for(i = 0 ; i < NUM_TILES ; i++){
+    code = CELL(board, i) ;
+
+    *(top_left + i) = CODE_TILE(code) ;
+  }
+
+  return ;
+}
+
+/*
+ * Slides the tile in cell tile into the blank cell. XOR of
+ * the tile's code and BLANK_CODE swaps the two in each cell.
+ */
+Packed slide_tile(Packed board, int tile, int blank)
+{
+  Packed swap ;
+
+  swap = (Packed)(CELL(board, tile) ^ BLANK_CODE) ;
+
+  return board ^ (swap << (tile * CELL_BITS)) ^ \
+  (swap << (blank * CELL_BITS)) ;
+}
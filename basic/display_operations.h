@@ -1,11 +1,13 @@
 /* 
  * Header file including all display/print related functions
- * for 8-tile program. The linked data structure, 
- * Puzzle, is defined on line 71. 
+ * for 8-tile program. The data structure, Puzzle, and the
+ * Arena holding every Puzzle are defined in the header
+ * arena_operations.h. 
  */
 #include <stdlib.h>
 #include "large_numbers.h"
 #include "neillncurses.h"
+#include "arena_operations.h"
 
 /* Errors related to the creation of the display. */ 
 #define DISPLAY_ERROR "\nERROR: Unexpected tile position " \
@@ -67,37 +69,31 @@
 #define MDL 1
 #define BTM 2
 
-/* Puzzle: Dynamic data structure used throughout program.*/
-struct puzzle{
-  char board[YS][XS] ; 
-  int parent ;
-  struct puzzle *next ; 
-} ; 
-typedef struct puzzle Puzzle ;
-
-void display_solution(Puzzle *start, int queue_place) ; 
-void sort_print_array(Puzzle *start, \
+void display_solution(Arena *arena, int queue_place, \
+Search_Stats *stats) ; 
+void sort_print_array(Arena *arena, \
 int print_steps[Q_MAX], int *num, int queue_place) ;
-void record_of_solution(Puzzle *start, int *print_steps, \
+void record_of_solution(Arena *arena, int *print_steps, \
 int steps) ; 
+void record_of_search(Search_Stats *stats) ; 
+void record_of_sweep(Arena *arena, long *size, int layers) ; 
 void define_colour_scheme(NCURS_Simplewin *move) ; 
 void puzzle_introduction(NCURS_Simplewin *move, \
 Puzzle *start) ; 
 void make_array_big(char normal[YS][XS], \
 char big[DISP_SIZE][DISP_SIZE]) ; 
 void solution_graphic(NCURS_Simplewin *move, \
-Puzzle *start, int print_steps[Q_MAX], int moves) ;
-void moving_display(NCURS_Simplewin *move, Puzzle *start, \
+Arena *arena, int print_steps[Q_MAX], int moves) ;
+void moving_display(NCURS_Simplewin *move, Arena *arena, \
 int print_steps) ; 
 void determine_tile_position(int k, int *y, int *x) ;
 void determine_tile(char change[TILE_SIZE][TILE_SIZE], \
 char tile) ; 
-void pointer_chase(Puzzle **start, Puzzle **location, \
-int displacement) ;
 
 
 /* Solution displayed with ncurses, with record of steps. */
-void display_solution(Puzzle *start, int queue_place)
+void display_solution(Arena *arena, int queue_place, \
+Search_Stats *stats)
 {
   NCURS_Simplewin disp ;
   int prints, *steps ;
@@ -108,27 +104,29 @@ void display_solution(Puzzle *start, int queue_place)
   prints = 0 ; 
   steps = &prints ;  
 
-  sort_print_array(start, print_steps, steps, queue_place);
+  sort_print_array(arena, print_steps, steps, queue_place);
     
-  record_of_solution(start, print_steps, MOVES(prints)) ;
+  record_of_solution(arena, print_steps, MOVES(prints)) ;
+  
+  record_of_search(stats) ;
 
   Neill_NCURS_Init(&disp) ;
     
   define_colour_scheme(&disp) ;
       
-  puzzle_introduction(&disp, start) ;
+  /* The starting board is always the first in the arena. */
+  puzzle_introduction(&disp, NODE(arena, 0)) ;
   
-  solution_graphic(&disp, start, print_steps, \
+  solution_graphic(&disp, arena, print_steps, \
   MOVES(prints)) ; 
    
   return ; 
 }
 
 /* Fills array with each correct board location in queue. */ 
-void sort_print_array(Puzzle *start, \
+void sort_print_array(Arena *arena, \
 int print_steps[Q_MAX], int *steps, int queue_place)
 {
-  Puzzle *position ; 
   int i, j ;
   
   i = 0 ; 
@@ -139,10 +137,8 @@ int print_steps[Q_MAX], int *steps, int queue_place)
     /* Fill array with parent's position in queue. */ 
     print_steps[i] = j ;
     
-    /* Pointer chase to parent board location in queue. */ 
-    pointer_chase(&start, &position, j) ; 
-    
-    j = position->parent ;
+    /* Move to parent board location in queue. */ 
+    j = NODE(arena, j)->parent ;
      
     /* Counter the number of steps  to reach solution. */
     (*steps)++ ;
@@ -155,21 +151,21 @@ int print_steps[Q_MAX], int *steps, int queue_place)
 }
 
 /* Print record of steps to solution for the user. */  
-void record_of_solution(Puzzle *start, int *print_steps, \
+void record_of_solution(Arena *arena, int *print_steps, \
 int steps) 
 {
-  Puzzle *print ;
-  char *top_left ;  
+  char *top_left, print[YS][XS] ;  
   int i, j, track ; 
   
   track = 0 ; 
+  top_left = &print[0][0] ;
   
   for(j = steps ; j >= 0 ; j--){
     printf("\nBoard number %d:\n", track) ; 
     
-    pointer_chase(&start, &print, *(print_steps + j)) ; 
-
-    top_left = &print->board[0][0] ;
+    /* Boards are packed, so unpack before printing. */
+    unpack_board(NODE(arena, *(print_steps + j))->board, \
+    top_left) ; 
     
     /* Print board. */ 
     for(i = 0 ; i < NUM_TILES ; i++){
@@ -190,6 +186,61 @@ int steps)
   return ; 
 }
 
+/* Print how much work the search did to find solution. */
+void record_of_search(Search_Stats *stats)
+{
+  printf("Boards expanded: %ld\n", stats->expanded) ; 
+  
+  printf("Boards generated: %ld\n", stats->generated) ; 
+  
+  printf("Moves pruned: %ld\n\n", stats->pruned) ; 
+  
+  return ; 
+}
+
+/* 
+ * Print the number of boards at each number of moves from
+ * the solution, then the hardest boards (the last layer,
+ * which is at the back of the arena).
+ */
+void record_of_sweep(Arena *arena, long *size, int layers)
+{
+  char *top_left, print[YS][XS] ;  
+  int i, j ; 
+  
+  top_left = &print[0][0] ;
+  
+  printf("\nBoards at each number of moves from the " \
+  "solution:\n") ; 
+  
+  for(j = 0 ; j < layers ; j++){
+    printf("%d moves: %ld\n", j, *(size + j)) ; 
+  }
+  
+  printf("\nTotal number of boards: %d\n", arena->count) ; 
+  
+  printf("\nHardest boards (%d moves):\n", layers - 1) ; 
+  
+  for(j = arena->count - (int)*(size + layers - 1) ; \
+  j < arena->count ; j++){
+    unpack_board(NODE(arena, j)->board, top_left) ; 
+    
+    printf("\n") ; 
+    
+    for(i = 0 ; i < NUM_TILES ; i++){
+      printf("%c ", *(top_left + i)) ;
+      
+      if((END_OF_ROW(i) % XS) == 0){
+        printf("\n") ; 
+      }
+    }
+  }
+  
+  printf("\n") ; 
+  
+  return ; 
+}
+
 void define_colour_scheme(NCURS_Simplewin *move)
 {
   /*
@@ -224,10 +275,12 @@ Puzzle *start)
   char intro_1[LNGTH1] = INTRO1 ;
   char intro_2[LNGTH2] = INTRO2 ; 
   char intro_3[LNGTH3] = INTRO3 ;
-  char big[DISP_SIZE][DISP_SIZE] ; 
+  char big[DISP_SIZE][DISP_SIZE], normal[YS][XS] ; 
+  
+  unpack_board(start->board, &normal[0][0]) ; 
   
   /* Enlarges arrays to make display easier to read. */ 
-  make_array_big(start->board, big) ; 
+  make_array_big(normal, big) ; 
   
   /* Display array to screen, state length and height. */
   Neill_NCURS_PrintArray(intro_1, LNGTH1, L_HEIGHT, move) ;
@@ -374,7 +427,7 @@ char tile)
 
 /* Animated step-by-step guide to the solution. */ 
 void solution_graphic(NCURS_Simplewin *move, \
-Puzzle *start, int print_steps[Q_MAX], int moves)
+Arena *arena, int print_steps[Q_MAX], int moves)
 {
   int i ;
   
@@ -382,7 +435,7 @@ Puzzle *start, int print_steps[Q_MAX], int moves)
   
   while((!move->finished) && (i >= 0)){
   
-    moving_display(move, start, print_steps[i]) ;
+    moving_display(move, arena, print_steps[i]) ;
      
     Neill_NCURS_Delay(ONE_SECOND) ; 
     
@@ -396,15 +449,15 @@ Puzzle *start, int print_steps[Q_MAX], int moves)
 }
 
 /* Large visualisation of current the board for each step.*/
-void moving_display(NCURS_Simplewin *move, Puzzle *start, \
+void moving_display(NCURS_Simplewin *move, Arena *arena, \
 int print_steps)
 { 
-  Puzzle *position ; 
-  char big[DISP_SIZE][DISP_SIZE] ; 
-    
-  pointer_chase(&start, &position, print_steps) ; 
+  char big[DISP_SIZE][DISP_SIZE], normal[YS][XS] ; 
+  
+  unpack_board(NODE(arena, print_steps)->board, \
+  &normal[0][0]) ; 
   
-  make_array_big(position->board, big) ; 
+  make_array_big(normal, big) ; 
   
   Neill_NCURS_PrintArray(&big[0][0], DISP_SIZE, DISP_SIZE, \
   move) ;
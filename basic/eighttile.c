@@ -1,24 +1,33 @@
 /* 
  * The 8-tile Puzzle. Includes main() function. 
- * NB: Linked data structure, Puzzle, is defined in the 
- * display_operations.h file. 
+ * NB: Data structure, Puzzle, is defined in the 
+ * arena_operations.h file. 
  */
+/* Needed for the barriers of the parallel search. */
+#define _POSIX_C_SOURCE 200112L
 #include <stdio.h>
 #include <stdlib.h>
+#include <unistd.h>
 #include "file_operations.h"
 #include "display_operations.h"
+#include "rank_operations.h"
+#include "layer_operations.h"
+#include "tables.h"
 
 /* Error messages presented when unexpected behaviour. */ 
 #define ARGC_ERROR "\nERROR: Unexpected input.\nPlease " \
-"try something like: %s 8-Puzzle.txt\n\n"
+"try something like: %s 8-Puzzle.txt\nOr, to search from " \
+"both ends: %s -b 8-Puzzle.txt\nOr, to search a layer at " \
+"a time with N threads: %s -p -t N 8-Puzzle.txt\nOr, for " \
+"the moves from every board to the solution: %s -s\n\n"
 #define UNSOLVABLE_BOARD_ERROR "\nERROR: Unfortunately, " \
 "this board is unsolvable :(\nTry another!\n\n"
-#define MEMORY_ERROR "\nERROR: Unable to allocate space " \
-"for new board\n\n."
-#define CHECK_ERROR "\nERROR: Unexpected input for choice "\
-"of test.\nChoice input should either be 's' to test if " \
-"solution, or 'e' to test if board already exists.\n\n"
-#define MOVE_ERROR "\nERROR: Unexpected move.\n\n"
+#define OWNER_MEMORY_ERROR "\nERROR: Unable to allocate " \
+"space for the bidirectional search.\n\n"
+#define THREAD_ERROR "\nERROR: Unable to start a thread " \
+"of the parallel search.\n\n"
+#define TABLES_ERROR "\nERROR: Generated tables do not " \
+"match the bounds checks.\n\n"
 
 /* Height, width and total number of tiles. */
 #define YS 3
@@ -34,14 +43,50 @@
 /* Defines starting position (ie, original board in file).*/ 
 #define ROOT_NODE -1
 
-#define END_OF_QUEUE(queue_place) (queue_place + 1)
+/* Place of the solution in queue before it has been found.*/
+#define NOT_FOUND -1
 
-/* Used to distinguish between different checks of board. */
-#define IS_SOLUTION 's'
-#define ALREADY_EXISTS 'e'
+/* Starting board was not made by a move, so none to undo. */
+#define NO_MOVE -1
 
-/* Limits the upper_bound when checking if solution. */
-#define SOL_ONLY 1
+/* Every count in the search starts at zero. */
+#define NULL_STATS {0, 0, 0}
+
+/* 
+ * Command line flags to use the bidirectional search or the
+ * parallel search, with N threads (default, one per core).
+ * Sweep is given in place of the board, as it needs none.
+ */
+#define BIDIRECTIONAL_FLAG "-b"
+#define PARALLEL_FLAG "-p"
+#define THREADS_FLAG "-t"
+#define SWEEP_FLAG "-s"
+
+/* Search used to solve the board, chosen by the flags. */
+#define BFS bfs
+#define BIDIRECTIONAL bidirectional
+#define PARALLEL parallel_bfs
+
+enum engine {bfs, bidirectional, parallel_bfs} ; 
+typedef enum engine engine ;
+
+/* Boards of a layer taken by a thread at a time. */
+#define BFS_SHARE 256
+
+/* 
+ * Side of the bidirectional search that owns a board. Owner
+ * of each board is stored as side * (place in arena + 1), 
+ * so 0 means no side has reached the board as of yet.
+ */
+#define FORWARD 1
+#define BACKWARD -1
+#define UNOWNED 0
+#define OWNER(side, place) ((side) * ((place) + 1))
+#define OWNER_PLACE(owner) (abs(owner) - 1)
+#define OWNER_SIDE(owner) (((owner) > 0) ? FORWARD : BACKWARD)
+
+/* Blank of the solution is in the last cell. */
+#define SOLUTION_BLANK NUM_WO_BLANK
 
 /* 2D array representing the solution to 8-tile puzzle. */
 #define SOLUTION {{'1', '2', '3'}, {'4', '5', '6'}, \
@@ -49,10 +94,15 @@
 
 /* Four Possible move/swap directions - ie, N, E, S and W.*/
 #define MOVE_DIRECTIONS 4
+
+/* Most children a board can have, ie blank in centre. */
+#define MAX_CHILDREN MOVE_DIRECTIONS
 /* 
  * Bounds check used when determining if the blank tile \ 
  * could possibly be N, E, S or W, respectively, from the \
  * current tile, t (our position in 2D array from [0][0]).
+ * NB: Only used to check the tables in tables.h, which are
+ * used instead when searching.
  */
 #define NORTH_POSSIBLE(t) (t > XS - 1)
 #define EAST_POSSIBLE(t) (((t + 1) % XS) != 0)
@@ -74,71 +124,161 @@
 enum compass {north, east, south, west} ; 
 typedef enum compass compass ;
 
-void puzzle_from_file(char *argv, Puzzle **start, \
-Puzzle **current, int queue_place) ;
-Puzzle *allocate_space(char *top_left, int counter) ; 
-void find_optimal_solution(Puzzle *start, Puzzle *current, \
-int *qp) ;
-void pointer_chase(Puzzle **start, Puzzle **location, \
-int displacement) ;
-void define_options_and_explore(Puzzle *start, \
-Puzzle *current, int counter, int *qp, int *soln) ; 
+void puzzle_from_file(char *argv, Arena *arena) ;
+int allocate_space(Arena *arena, Packed board, int blank, \
+int last_blank, int counter) ; 
+int find_optimal_solution(Arena *arena, \
+unsigned char *visited, Search_Stats *stats) ;
+void define_options_and_explore(Arena *arena, int counter, \
+int *soln, unsigned char *visited, Search_Stats *stats) ; 
 void determine_search_directions(int tile, int *direction) ; 
-void search_possible_directions(int tile, int *direction, \
-Puzzle *start, Puzzle *current, int counter, int *qp, \
-int *soln) ;
-void create_next_board(Puzzle copy, int counter, int tile, \
-int direction, Puzzle *start, int *qp, int *soln) ; 
-void make_move(Puzzle *copy, int counter, int tile, \
-int dirctn) ; 
-int check_if_board(char choice, Puzzle *current, \
-Puzzle *start, int place) ;
-int test_against(Puzzle *test, char against[YS][XS], \
-int upper_bound) ;
-void free_malloc_memory(Puzzle *start) ;
+void check_tables(void) ;
+int generate_children(Puzzle *current, int counter, \
+Puzzle *children, Search_Stats *stats) ;
+void create_next_board(Puzzle *child, Arena *arena, \
+int *soln, unsigned char *visited) ; 
+void make_move(Puzzle *current, Puzzle *child, int counter, \
+int tile) ; 
+int check_if_solution(Puzzle *current) ;
+int bidirectional_search(Arena *forward, Arena *backward, \
+int *owner, Search_Stats *stats) ;
+int expand_layer(Arena *arena, int *layer, int side, \
+int *owner, int *meet, Search_Stats *stats) ;
+int *create_owner(void) ;
+int parallel_search(Layer *layer, Search_Stats *stats) ;
+void *layer_worker(void *arg) ;
+void expand_share(Layer *layer, int id) ;
+void join_layer(Layer *layer) ;
+void copy_buffer(Layer *layer, int id) ;
 
 
 int main(int argc, char *argv[])
 {
-  Puzzle *start = NULL, *current = NULL ;
-  int queue_place, *qp ;
-
-  /* Used to keep track of total number of unique boards. */ 
-  queue_place = 0 ; 
-  qp = &queue_place ; 
+  Arena arena, goal_arena ;
+  Layer layer ;
+  unsigned char *visited ;
+  int i, queue_place, *owner, threads ;
+  engine search ;
+  Search_Stats stats = NULL_STATS ;
   
   /* If we exit() anywhere in code, call this function. */
   atexit(Neill_NCURS_Done) ;   
+  
+  search = BFS ;
+  threads = (int)sysconf(_SC_NPROCESSORS_ONLN) ;
+  
+  /* Flags come first, the board file is always the last. */
+  for(i = 1 ; i < argc - 1 ; i++){
+    if(strcmp(argv[i], BIDIRECTIONAL_FLAG) == 0){
+      search = BIDIRECTIONAL ;
+    }
+    
+    else if(strcmp(argv[i], PARALLEL_FLAG) == 0){
+      search = PARALLEL ;
+    }
+    
+    else if((strcmp(argv[i], THREADS_FLAG) == 0) && \
+    (i + 2 < argc) && (atoi(argv[i + 1]) > 0)){
+      threads = atoi(argv[++i]) ;
+    }
+    
+    else{
+      argc = 0 ;
+    }
+  }
 
   /* Ensure that file is entered properly on command line.*/
-  if(argc == 2){
-      
-    puzzle_from_file(argv[1], &start, &current, \
-    queue_place) ;
+  if(argc < 2){
+    fprintf(stderr, ARGC_ERROR, argv[0], argv[0], argv[0], \
+    argv[0]) ;
+    return 1 ; 
+  }
+  
+#ifdef EIGHTTILE_DEBUG
+  check_tables() ;
+#endif
+  
+  threads = (threads > 0) ? threads : 1 ;
+  
+  create_arena(&arena) ;
+  
+  /* Every board, by a parallel search from the solution. */
+  if(strcmp(argv[argc - 1], SWEEP_FLAG) == 0){
+    visited = create_visited() ;
     
-    /* Define the starting board as not having a parent. */
-    start->parent = ROOT_NODE ; 
-              
-    find_optimal_solution(start, current, qp) ; 
-
-    display_solution(start, queue_place) ;
+    allocate_space(&arena, PACKED_SOLUTION, SOLUTION_BLANK, \
+    NO_MOVE, ROOT_NODE) ;
+    
+    create_layer(&layer, &arena, visited, threads, TRUE) ;
+    
+    parallel_search(&layer, &stats) ;
+    
+    record_of_sweep(&arena, layer.size, layer.layers) ;
+    
+    record_of_search(&stats) ;
+    
+    free_layer(&layer) ;
+    
+    free(visited) ;
+  }
+  
+  /* Search from the start and the solution until they meet.*/
+  else if(search == BIDIRECTIONAL){
+    owner = create_owner() ;
+    
+    create_arena(&goal_arena) ;
+    
+    puzzle_from_file(argv[argc - 1], &arena) ;
+    
+    /* Goal side starts from the solution, in its own arena. */
+    allocate_space(&goal_arena, PACKED_SOLUTION, \
+    SOLUTION_BLANK, NO_MOVE, ROOT_NODE) ;
+    
+    queue_place = bidirectional_search(&arena, &goal_arena, \
+    owner, &stats) ; 
+    
+    display_solution(&arena, queue_place, &stats) ;
     
-    free_malloc_memory(start) ;
+    free_arena(&goal_arena) ;
+    
+    free(owner) ;
   }
   
   else{
-    fprintf(stderr, ARGC_ERROR, argv[0]) ;
-    return 1 ; 
+    visited = create_visited() ;
+      
+    puzzle_from_file(argv[argc - 1], &arena) ;
+    
+    /* Place of the solution in the queue (ie, arena). */
+    if(search == PARALLEL){
+      create_layer(&layer, &arena, visited, threads, FALSE) ;
+      
+      queue_place = parallel_search(&layer, &stats) ; 
+      
+      free_layer(&layer) ;
+    }
+    
+    else{
+      queue_place = find_optimal_solution(&arena, visited, \
+      &stats) ; 
+    }
+
+    display_solution(&arena, queue_place, &stats) ;
+    
+    free(visited) ;
   }
   
+  free_arena(&arena) ;
+  
   return 0 ; 
 }
 
 /* All file related functions - see relevant header. */
-void puzzle_from_file(char *argv, Puzzle **start, \
-Puzzle **current, int queue_place) 
+void puzzle_from_file(char *argv, Arena *arena) 
 {
   FILE *et = NULL ;
+  Packed board ;
+  int blank ;
   char *fb, first_board[YS][XS] = NULL_BOARD ;
   
   fb = &first_board[0][0] ;
@@ -148,114 +288,128 @@ Puzzle **current, int queue_place)
   check_file_and_fill_first_board(et, fb, argv) ; 
     
   close_file(&et, argv) ;
-        
-  *start = *current = allocate_space(fb, queue_place) ;
+  
+  /* From here on, the solver only uses the packed board. */
+  board = pack_board(fb) ;
+  
+  for(blank = 0 ; *(fb + blank) != BLANK ; blank++) ; 
+  
+  /* Define the starting board as not having a parent. */
+  allocate_space(arena, board, blank, NO_MOVE, ROOT_NODE) ;
     
   return ; 
 }
 
-/* Allocates space in memory for new board. */  
-Puzzle *allocate_space(char *top_left, int counter)
+/* Adds new board to the back of the queue (ie, arena). */  
+int allocate_space(Arena *arena, Packed board, int blank, \
+int last_blank, int counter)
 {
   Puzzle *new = NULL;
-  int i ;
-  char *fill ;
+  int place ;
   
-  new = (Puzzle *)malloc(sizeof(Puzzle)) ;
+  place = new_board(arena) ;
   
-  fill = &new->board[0][0] ; 
-    
-  if(new == NULL){
-    fprintf(stderr, MEMORY_ERROR) ; 
-    exit(EXIT_FAILURE) ; 
-  }
-        
-  for(i = 0 ; i < NUM_TILES ; i++){
-    *(fill + i) = *(top_left + i) ; 
-  }
+  new = NODE(arena, place) ;
   
-  new->parent = counter ; 
+  new->board = board ; 
   
-  new->next = NULL ;
+  new->blank = blank ; 
+  
+  new->last_blank = last_blank ; 
+  
+  new->parent = counter ; 
       
-  return new ; 
+  return place ; 
 }
 
-/* Finds the optimum solution for a solvable puzzle. */ 
-void find_optimal_solution(Puzzle *start, Puzzle *current, \
-int *qp) 
+/* Finds the optimum solution, returns its place in queue.*/ 
+int find_optimal_solution(Arena *arena, \
+unsigned char *visited, Search_Stats *stats) 
 { 
   /* Used to keep track of which board in queue we are at.*/  
-  static int counter =  0 ;
+  int counter ;
   
   /* Lets us test for solution when we create a new board.*/
-  int correct_board, *soln ;
+  int solution, *soln ;
+  
+  counter = 0 ; 
+  solution = NOT_FOUND ; 
+  soln = &solution ; 
   
-  correct_board = FALSE ; 
-  soln = &correct_board ; 
+  /* The first board is the first board to be visited. */
+  MARK_VISITED(visited, board_rank(NODE(arena, 0)->board)) ;
     
   /* 
    * Checks if any 'child' board created in previous 
    * iterations is solutions. Continues if not.  
    */
-  while(correct_board != TRUE){
-    pointer_chase(&start, &current, counter) ; 
-
+  while(solution == NOT_FOUND){
     /* Incr counter after fctn called to move along queue.*/  
-    define_options_and_explore(start, current, counter++, \
-    qp, soln) ;
+    define_options_and_explore(arena, counter++, soln, \
+    visited, stats) ;
      
     /* Unsolvable if we cannot find solution in queue. */      
-    if(counter == END_OF_QUEUE(*qp)){
+    if(counter == arena->count){
       fprintf(stderr, UNSOLVABLE_BOARD_ERROR) ; 
       exit(EXIT_FAILURE) ; 
     }
   }
     
-  return ; 
+  return solution ; 
 }
 
-/* Moves us along the linked list to required position. */ 
-void pointer_chase(Puzzle **start, Puzzle **location, \
-int displacement)
+/* Creates each child of the board, then checks each one. */
+void define_options_and_explore(Arena *arena, int counter, \
+int *soln, unsigned char *visited, Search_Stats *stats) 
 {
-  Puzzle *temp ; 
-  int i ; 
+  /* Filled with children on the stack, so no allocation. */
+  Puzzle children[MAX_CHILDREN] ; 
+  int i, num_children ;
   
-  temp = *start ;
+  stats->expanded++ ; 
   
-  for(i = 0 ; i < displacement ; i++){
-    temp = temp->next ; 
+  num_children = generate_children(NODE(arena, counter), \
+  counter, children, stats) ; 
+  
+  for(i = 0 ; i < num_children ; i++){
+    create_next_board(&children[i], arena, soln, visited) ; 
   }
   
-  *location = temp ; 
-    
   return ;
 }
 
-/* For each tile, bounds the directions we look for blank.*/
-void define_options_and_explore(Puzzle *start, \
-Puzzle *current, int counter, int *qp, int *soln) 
+/* 
+ * Only tiles next to the blank can move (see tables.h), so
+ * fills children with the legal children of current and
+ * returns how many there are (1 to MAX_CHILDREN). The move
+ * that made current acts as the state of a simple automaton
+ * that never allows its inverse, as sliding the tile back
+ * into last_blank would only recreate the parent.
+ */
+int generate_children(Puzzle *current, int counter, \
+Puzzle *children, Search_Stats *stats)
 {
-  char *top_left ;
-  int tile ;
-   
-  /* Stores values used in pntr arthm to reach N, E, S, W.*/
-  int search_direction[MOVE_DIRECTIONS] ;
+  int i, tile, blank, num_children ;
+  
+  blank = current->blank ; 
+  num_children = 0 ; 
+  
+  for(i = 0 ; i < neighbour_count[blank] ; i++){
+    tile = neighbour[blank][i] ; 
     
-  top_left = &current->board[0][0] ; 
+    if(tile == current->last_blank){
+      stats->pruned++ ; 
+    }
     
-  for(tile = 0 ; tile < NUM_TILES ; tile++){
-    /* If currently blank tile, no point doing anything! */ 
-    if(*(top_left + tile) != BLANK){
-      determine_search_directions(tile, search_direction) ;
-         
-      search_possible_directions(tile, search_direction, \
-      start, current, counter, qp, soln) ;   
+    else{
+      make_move(current, &children[num_children++], counter, \
+      tile) ; 
     }
   }
   
-  return ;
+  stats->generated += num_children ; 
+  
+  return num_children ; 
 }
 
 /* Bounds checks - is possible to search N, E, S, W. */ 
@@ -281,150 +435,433 @@ void determine_search_directions(int tile, int *direction)
   return ; 
 }
 
-/* Checks adjacent tiles using pointer arithmetic */ 
-void search_possible_directions(int tile, int *direction, \
-Puzzle *start, Puzzle *current, int counter, int *qp, \
-int *soln)
+/* 
+ * Debug only - checks that the tiles next to each blank cell
+ * in tables.h are exactly the tiles found by bounds checks.
+ */
+void check_tables(void)
 {
-  Puzzle copy ; 
-  int i ; 
-  char *tile_location ;
-          
-  for(i = 0 ; i < MOVE_DIRECTIONS ; i++){
-    copy = *current ;
-    
-    tile_location = &copy.board[0][0] + tile ;
-    /* 
-     * If adjacent tile is the blank tile, then create next\
-     * board. Okay if direction[i] is zero, as the tile we \
-     * are evaluating can never be the blank tile, as above. 
-     */
-    if(*(tile_location + direction[i]) == BLANK){
-      create_next_board(copy, counter, tile, direction[i], \
-      start, qp, soln) ; 
+  int blank, tile, i, found ;
+  int search_direction[MOVE_DIRECTIONS] ;
+  
+  for(blank = 0 ; blank < NUM_TILES ; blank++){
+    found = 0 ; 
+    
+    for(tile = 0 ; tile < NUM_TILES ; tile++){
+      if(tile != blank){
+        determine_search_directions(tile, search_direction) ;
+        
+        for(i = 0 ; i < MOVE_DIRECTIONS ; i++){
+          if(tile + search_direction[i] == blank){
+            /* Tiles are found in ascending order, as table. */
+            if((found >= neighbour_count[blank]) || \
+            (neighbour[blank][found] != tile)){
+              fprintf(stderr, TABLES_ERROR) ; 
+              exit(EXIT_FAILURE) ; 
+            }
+            
+            found++ ; 
+          }
+        }
+      }
+    }
+    
+    if(found != neighbour_count[blank]){
+      fprintf(stderr, TABLES_ERROR) ; 
+      exit(EXIT_FAILURE) ; 
     }
   }
   
   return ; 
 }
 
-/* Creates next board and checks whether already exists. */
-void create_next_board(Puzzle copy, int counter, int tile, \
-int direction, Puzzle *start, int *qp, int *soln)
+/* Checks whether next board already exists, else adds it. */
+void create_next_board(Puzzle *child, Arena *arena, \
+int *soln, unsigned char *visited)
 {
-  Puzzle *potential = NULL;
-  char *top_left ;
-
-  top_left = &copy.board[0][0] ; 
-
-  /* Create new board by making appropriate move. */
-  make_move(&copy, counter, tile, direction) ; 
+  unsigned long rank ;
+  int place ;
   
-  potential = &copy ; 
+  rank = board_rank(child->board) ;
   
   /* If new board does not exist, add to back of queue. */  
-  if(!check_if_board(ALREADY_EXISTS, potential, start, \
-  *qp)){
-    pointer_chase(&start, &potential, (*qp)++) ; 
+  if(!IS_VISITED(visited, rank)){
+    MARK_VISITED(visited, rank) ; 
     
-    potential->next = allocate_space(top_left, counter) ;
-    
-    potential = potential->next ;
+    place = allocate_space(arena, child->board, child->blank, \
+    child->last_blank, child->parent) ;
     
     /* Flag if new board is solution, then we can stop. */
-    *soln = check_if_board(IS_SOLUTION, potential, start, \
-    *qp) ; 
-    
+    if(check_if_solution(NODE(arena, place))){
+      *soln = place ; 
+    }
+
   }
   
   return ; 
 }
 
-/* Swaps tile with blank tile and updates parent value. */
-void make_move(Puzzle *copy, int counter, int tile, \
-int dirctn)
+/* Child is current with tile swapped with the blank tile. */
+void make_move(Puzzle *current, Puzzle *child, int counter, \
+int tile)
 { 
-  char *t ; 
-  
-  t = &copy->board[0][0] + tile ; 
-
   /* Swap blank (in N, E, S, or W cell) with number tile. */ 
-  switch(dirctn){
-    case MOVE_N : *(t + dirctn) = *t ; *t = BLANK ; break ;
-    case MOVE_E : *(t + dirctn) = *t ; *t = BLANK ; break ; 
-    case MOVE_S : *(t + dirctn) = *t ; *t = BLANK ; break ;
-    case MOVE_W : *(t + dirctn) = *t ; *t = BLANK ; break ;
-    /*Use default case to catch any unexpected moves. */
-    default : fprintf(stderr, MOVE_ERROR) ; 
-    exit(EXIT_FAILURE) ; 
-  } 
+  child->board = slide_tile(current->board, tile, \
+  current->blank) ;
+  
+  /* Tile has moved, so blank is now where tile was. */
+  child->blank = tile ; 
+  
+  /* Remember the move, so that it is not undone. */
+  child->last_blank = current->blank ; 
   
-  copy->parent = counter ;
+  child->parent = counter ;
   
   return ; 
 }
 
-/* Either check if board is solution or already exists. */
-int check_if_board(char choice, Puzzle *current, \
-Puzzle *start, int place)
+/* Checks if board is the solution, ie a single compare. */
+int check_if_solution(Puzzle *current)
 {
-  Puzzle *test ;
-  int check, match ;
-  char sol[YS][XS] = SOLUTION ; 
-    
-  check = FALSE ;
-  match = 0 ; 
-  
-  /* variable choice defines which check we carry out. */
-  switch(choice){
-    case IS_SOLUTION : test = current ; 
-    match = test_against(test, sol, SOL_ONLY) ; 
-    break ; 
-    case ALREADY_EXISTS : test = start ; 
-    match = test_against(test, current->board, place) ;
-    break ; 
-    /* Catches any error when specifying type of check. */ 
-    default : fprintf(stderr, CHECK_ERROR) ; 
-    exit(EXIT_FAILURE) ; 
+  if(current->board == PACKED_SOLUTION){
+    return TRUE ; 
   }
   
-  (match > 0) ? (check = TRUE) : (check = FALSE) ;
-  
-  return check ; 
+  return FALSE ; 
 }
 
-/* Lets us carry out the relevant test, using the bounds
- * defined in the function above. If any matches, then flag.
+/* 
+ * Bidirectional BFS: a layer (all boards the same number of
+ * moves from its root) is expanded from the start or from
+ * the solution, whichever has fewer boards waiting, until a
+ * board reached by one side is found by the other. As whole
+ * layers are expanded, the first such board is on a path of
+ * the fewest moves. The goal half of the path is then added
+ * to the start's arena, so the solution is displayed as is.
  */
-int test_against(Puzzle *test, char against[YS][XS], \
-int upper_bound)
+int bidirectional_search(Arena *forward, Arena *backward, \
+int *owner, Search_Stats *stats)
 {
-  int i, match ; 
+  int forward_layer, backward_layer, met, meet[2] ;
+  int end, start, counter ;
+  Puzzle *goal_board ;
   
-  match = 0 ; 
+  if(check_if_solution(NODE(forward, 0))){
+    return 0 ; 
+  }
+  
+  owner[board_rank(NODE(forward, 0)->board)] = \
+  OWNER(FORWARD, 0) ;
+  owner[SOLUTION_RANK] = OWNER(BACKWARD, 0) ;
   
-  for(i = 0 ; i < upper_bound ; i++){
-    if(memcmp(test->board, against, sizeof(char[YS][XS])) \
-    == 0){
-      match++ ; 
+  forward_layer = backward_layer = 0 ; 
+  met = FALSE ; 
+  
+  while(!met){
+    /* Unsolvable if either side runs out of boards. */
+    if((forward->count == forward_layer) || \
+    (backward->count == backward_layer)){
+      fprintf(stderr, UNSOLVABLE_BOARD_ERROR) ; 
+      exit(EXIT_FAILURE) ; 
     }
     
-    test = test->next ; 
+    if(forward->count - forward_layer <= \
+    backward->count - backward_layer){
+      met = expand_layer(forward, &forward_layer, FORWARD, \
+      owner, meet, stats) ; 
+      
+      /* meet: parent (start side), child (goal side). */
+      end = meet[0] ; 
+      start = meet[1] ; 
+    }
+    
+    else{
+      met = expand_layer(backward, &backward_layer, BACKWARD, \
+      owner, meet, stats) ; 
+      
+      /* meet: parent (goal side), child (start side). */
+      end = meet[1] ; 
+      start = meet[0] ; 
+    }
+  }
+  
+  /* Walks from the meeting board to the solution. */
+  counter = end ; 
+  
+  while(start != ROOT_NODE){
+    goal_board = NODE(backward, start) ; 
+    
+    counter = allocate_space(forward, goal_board->board, \
+    goal_board->blank, NO_MOVE, counter) ; 
+    
+    start = goal_board->parent ; 
   }
+  
+  return counter ; 
+}
 
-  return match ; 
+/* 
+ * Expands every board in the newest layer of one side. If a
+ * child has been reached by the other side, meet is set to
+ * the parent's place and the child's place in the other 
+ * side's arena, and TRUE is returned.
+ */
+int expand_layer(Arena *arena, int *layer, int side, \
+int *owner, int *meet, Search_Stats *stats)
+{
+  Puzzle children[MAX_CHILDREN] ; 
+  unsigned long rank ; 
+  int i, end, counter, place, num_children ; 
+  
+  end = arena->count ; 
+  
+  for(counter = *layer ; counter < end ; counter++){
+    stats->expanded++ ; 
+    
+    num_children = generate_children(NODE(arena, counter), \
+    counter, children, stats) ; 
+    
+    for(i = 0 ; i < num_children ; i++){
+      rank = board_rank(children[i].board) ; 
+      
+      if(owner[rank] == UNOWNED){
+        place = allocate_space(arena, children[i].board, \
+        children[i].blank, children[i].last_blank, counter) ; 
+        
+        owner[rank] = OWNER(side, place) ; 
+      }
+      
+      else if(OWNER_SIDE(owner[rank]) != side){
+        meet[0] = counter ; 
+        meet[1] = OWNER_PLACE(owner[rank]) ; 
+        
+        return TRUE ; 
+      }
+    }
+  }
+  
+  /* Children just added are the next layer to expand. */
+  *layer = end ; 
+  
+  return FALSE ; 
 }
 
-/* Frees all memory that has been allocated using malloc. */
-void free_malloc_memory(Puzzle *start)
+/* Owner of every board, ie neither side to begin with. */
+int *create_owner(void)
 {
-  Puzzle *clear ; 
+  int *owner ; 
+  
+  owner = (int *)calloc(Q_MAX, sizeof(int)) ; 
+  
+  if(owner == NULL){
+    fprintf(stderr, OWNER_MEMORY_ERROR) ; 
+    exit(EXIT_FAILURE) ; 
+  }
   
-  while((clear = start) != NULL){
-    start = start->next ; 
+  return owner ; 
+}
+
+/* 
+ * Parallel BFS: each layer is shared out between the threads
+ * (the calling thread is thread 0), which all wait for the 
+ * others at a barrier before the next layer, so boards are 
+ * still added a whole layer at a time and the solution is 
+ * the fewest moves. Returns the place of the solution, or 
+ * when sweeping, LAYER_NOT_FOUND once every board is added.
+ */
+int parallel_search(Layer *layer, Search_Stats *stats)
+{
+  pthread_t *thread ; 
+  Layer_Worker *worker ; 
+  int i ; 
+  
+  MARK_VISITED(layer->visited, \
+  board_rank(NODE(layer->arena, 0)->board)) ;
+  
+  if(!layer->sweep && check_if_solution(NODE(layer->arena, 0))){
+    return 0 ; 
+  }
+  
+  thread = (pthread_t *)malloc(layer->threads * \
+  sizeof(pthread_t)) ; 
+  
+  worker = (Layer_Worker *)malloc(layer->threads * \
+  sizeof(Layer_Worker)) ; 
+  
+  if((thread == NULL) || (worker == NULL)){
+    fprintf(stderr, LAYER_MEMORY_ERROR) ; 
+    exit(EXIT_FAILURE) ; 
+  }
+  
+  for(i = 0 ; i < layer->threads ; i++){
+    worker[i].layer = layer ; 
+    worker[i].id = i ; 
+  }
+  
+  for(i = 1 ; i < layer->threads ; i++){
+    if(pthread_create(&thread[i], NULL, layer_worker, \
+    &worker[i]) != 0){
+      fprintf(stderr, THREAD_ERROR) ; 
+      exit(EXIT_FAILURE) ; 
+    }
+  }
+  
+  layer_worker(&worker[0]) ; 
+  
+  for(i = 1 ; i < layer->threads ; i++){
+    pthread_join(thread[i], NULL) ; 
+  }
+  
+  free(worker) ; 
+  free(thread) ; 
+  
+  for(i = 0 ; i < layer->threads ; i++){
+    stats->expanded += layer->stats[i].expanded ; 
+    stats->generated += layer->stats[i].generated ; 
+    stats->pruned += layer->stats[i].pruned ; 
+  }
+  
+  /* Unsolvable if every board is added without solution. */
+  if(!layer->sweep && (layer->solution == LAYER_NOT_FOUND)){
+    fprintf(stderr, UNSOLVABLE_BOARD_ERROR) ; 
+    exit(EXIT_FAILURE) ; 
+  }
+  
+  return layer->solution ; 
+}
+
+/* One thread, until a layer holds the solution or is empty.*/
+void *layer_worker(void *arg)
+{
+  Layer_Worker *worker ; 
+  Layer *layer ; 
+  
+  worker = (Layer_Worker *)arg ; 
+  layer = worker->layer ; 
+  
+  while(1){
+    expand_share(layer, worker->id) ; 
+    
+    pthread_barrier_wait(&layer->barrier) ; 
+    
+    /* One thread places every buffer in the next layer. */
+    if(worker->id == 0){
+      join_layer(layer) ; 
+    }
+    
+    pthread_barrier_wait(&layer->barrier) ; 
+    
+    copy_buffer(layer, worker->id) ; 
+    
+    pthread_barrier_wait(&layer->barrier) ; 
+    
+    if(layer->stop){
+      return NULL ; 
+    }
+  }
+}
+
+/* 
+ * Expands boards of the layer, BFS_SHARE at a time, until 
+ * every board has been taken. A child is only added (to the
+ * thread's buffer) by the thread that marks it visited.
+ */
+void expand_share(Layer *layer, int id)
+{
+  Puzzle children[MAX_CHILDREN] ; 
+  Buffer *buffer ; 
+  Search_Stats *stats ; 
+  unsigned long rank ; 
+  int i, first, last, counter, num_children ; 
+  
+  buffer = &layer->buffer[id] ; 
+  stats = &layer->stats[id] ; 
+  
+  while((first = __atomic_fetch_add(&layer->next, BFS_SHARE, \
+  __ATOMIC_RELAXED)) < layer->end){
+    last = (first + BFS_SHARE < layer->end) ? \
+    (first + BFS_SHARE) : layer->end ; 
     
-    free(clear) ; 
+    for(counter = first ; counter < last ; counter++){
+      stats->expanded++ ; 
+      
+      num_children = generate_children(NODE(layer->arena, \
+      counter), counter, children, stats) ; 
+      
+      for(i = 0 ; i < num_children ; i++){
+        rank = board_rank(children[i].board) ; 
+        
+        if(!TEST_AND_MARK(layer->visited, rank)){
+          add_to_buffer(buffer, &children[i]) ; 
+          
+          if(!layer->sweep && check_if_solution(&children[i])){
+            layer->found = id ; 
+            layer->found_place = buffer->count - 1 ; 
+          }
+        }
+      }
+    }
+  }
+  
+  return ; 
+}
+
+/* 
+ * Reserves the next layer in the arena, with each buffer 
+ * after the last, and decides if the search is over.
+ */
+void join_layer(Layer *layer)
+{
+  int i, first, total ; 
+  
+  total = 0 ; 
+  
+  for(i = 0 ; i < layer->threads ; i++){
+    layer->offset[i] = total ; 
+    total += layer->buffer[i].count ; 
+  }
+  
+  first = reserve_boards(layer->arena, total) ; 
+  
+  for(i = 0 ; i < layer->threads ; i++){
+    layer->offset[i] += first ; 
+  }
+  
+  if(layer->found != LAYER_NOT_FOUND){
+    layer->solution = layer->offset[layer->found] + \
+    layer->found_place ; 
+    layer->stop = TRUE ; 
+  }
+  
+  /* No new boards, so every reachable board is added. */
+  if(total == 0){
+    layer->stop = TRUE ; 
+  }
+  
+  else if(layer->layers < LAYER_LIMIT){
+    layer->size[layer->layers++] = total ; 
+  }
+  
+  layer->start = layer->next = layer->end ; 
+  layer->end = layer->arena->count ; 
+  
+  return ; 
+}
+
+/* Copies the thread's buffer to its place in the arena. */
+void copy_buffer(Layer *layer, int id)
+{
+  Buffer *buffer ; 
+  int i ; 
+  
+  buffer = &layer->buffer[id] ; 
+  
+  for(i = 0 ; i < buffer->count ; i++){
+    *NODE(layer->arena, layer->offset[id] + i) = \
+    buffer->board[i] ; 
   }
   
+  buffer->count = 0 ; 
+  
   return ; 
 }
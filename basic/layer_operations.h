@@ -0,0 +1,157 @@
+/*
+ * Header including the parts of the parallel breadth first
+ * search of 8-tile. Each layer (all boards the same number
+ * of moves from the start) is shared out between threads,
+ * which mark boards in the visited bitmap with an atomic
+ * test-and-set and keep the children they add in their own
+ * buffer. Once every thread is done (at a barrier), the
+ * buffers are copied, in order, into the arena as the next
+ * layer.
+ */
+#include <stdlib.h>
+#include <pthread.h>
+
+#define LAYER_MEMORY_ERROR "\nERROR: Unable to allocate " \
+"space for the parallel search.\n\n"
+
+/* Solution is not in the layer (or any before it). */
+#define LAYER_NOT_FOUND -1
+
+/* Initial number of boards each buffer can hold. */
+#define BUFFER_START 1024
+
+/*
+ * Most layers recorded, the longest solution of a 3x3 board
+ * is 31 moves, so there are no more than 32.
+ */
+#define LAYER_LIMIT 64
+
+/* Buffer: children one thread adds to the next layer. */
+struct buffer{
+  Puzzle *board ;
+  int count ;
+  int size ;
+} ;
+typedef struct buffer Buffer ;
+
+/*
+ * Layer: what the threads share. The layer being expanded
+ * is boards start to end - 1 of the arena, and next is the
+ * first board not yet taken by a thread. If the solution is
+ * added, found is the thread that added it and found_place
+ * its place in that thread's buffer.
+ */
+struct layer{
+  Arena *arena ;
+  unsigned char *visited ;
+  Buffer *buffer ;
+  Search_Stats *stats ;
+  int *offset ;
+  pthread_barrier_t barrier ;
+  int threads ;
+  int sweep ;
+  int start ;
+  int end ;
+  int next ;
+  int found ;
+  int found_place ;
+  int solution ;
+  int stop ;
+  int layers ;
+  long size[LAYER_LIMIT] ;
+} ;
+typedef struct layer Layer ;
+
+/* Layer_Worker: what each thread is started with. */
+struct layer_worker{
+  Layer *layer ;
+  int id ;
+} ;
+typedef struct layer_worker Layer_Worker ;
+
+void create_layer(Layer *layer, Arena *arena, \
+unsigned char *visited, int threads, int sweep) ;
+void add_to_buffer(Buffer *buffer, Puzzle *board) ;
+void free_layer(Layer *layer) ;
+
+
+/* Every buffer starts empty, the first layer is the start.*/
+void create_layer(Layer *layer, Arena *arena, \
+unsigned char *visited, int threads, int sweep)
+{
+  int i ;
+
+  layer->buffer = (Buffer *)malloc(threads * sizeof(Buffer)) ;
+
+  layer->stats = (Search_Stats *)calloc(threads, \
+  sizeof(Search_Stats)) ;
+
+  layer->offset = (int *)malloc(threads * sizeof(int)) ;
+
+  if((layer->buffer == NULL) || (layer->stats == NULL) || \
+  (layer->offset == NULL)){
+    fprintf(stderr, LAYER_MEMORY_ERROR) ;
+    exit(EXIT_FAILURE) ;
+  }
+
+  for(i = 0 ; i < threads ; i++){
+    layer->buffer[i].board = NULL ;
+    layer->buffer[i].count = layer->buffer[i].size = 0 ;
+  }
+
+  pthread_barrier_init(&layer->barrier, NULL, threads) ;
+
+  layer->arena = arena ;
+  layer->visited = visited ;
+  layer->threads = threads ;
+  layer->sweep = sweep ;
+  layer->start = layer->next = 0 ;
+  layer->end = arena->count ;
+  layer->found = layer->found_place = LAYER_NOT_FOUND ;
+  layer->solution = LAYER_NOT_FOUND ;
+  layer->stop = 0 ;
+
+  /* Starting board is the only board in the first layer. */
+  layer->layers = 1 ;
+  layer->size[0] = arena->count ;
+
+  return ;
+}
+
+/* Adds board to the end of buffer, doubled whenever full. */
+void add_to_buffer(Buffer *buffer, Puzzle *board)
+{
+  if(buffer->count == buffer->size){
+    buffer->size = (buffer->size == 0) ? BUFFER_START : \
+    (2 * buffer->size) ;
+
+    buffer->board = (Puzzle *)realloc(buffer->board, \
+    buffer->size * sizeof(Puzzle)) ;
+
+    if(buffer->board == NULL){
+      fprintf(stderr, LAYER_MEMORY_ERROR) ;
+      exit(EXIT_FAILURE) ;
+    }
+  }
+
+  buffer->board[buffer->count++] = *board ;
+
+  return ;
+}
+
+void free_layer(Layer *layer)
+{
+  int i ;
+
+  for(i = 0 ; i < layer->threads ; i++){
+    free(layer->buffer[i].board) ;
+  }
+
+  pthread_barrier_destroy(&layer->barrier) ;
+
+  free(layer->buffer) ;
+  free(layer->stats) ;
+  free(layer->offset) ;
+
+  return ;
+}
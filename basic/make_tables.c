@@ -0,0 +1,105 @@
+/*
+ * Generates tables.h for 8-tile, run by the makefile before
+ * 8-tile is compiled. The tables only depend on the size of
+ * the board, so are worked out once here rather than on
+ * every move. Writes the header to standard output.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include "file_operations.h"
+
+#define MOVE_DIRECTIONS 4
+
+void print_header(void) ;
+void print_neighbours(void) ;
+void print_row(int *row, int length, char *end) ;
+
+
+int main(void)
+{
+  print_header() ;
+
+  print_neighbours() ;
+
+  return 0 ;
+}
+
+/* Stops the tables being used with another board size. */
+void print_header(void)
+{
+  printf("/*\n * Generated by make_tables.c for a %dx%d board" \
+  " - do not edit.\n */\n", YS, XS) ;
+
+  printf("#if (YS != %d) || (XS != %d)\n", YS, XS) ;
+  printf("#error \"tables.h was generated for another board " \
+  "size, run make.\"\n") ;
+  printf("#endif\n\n") ;
+
+  return ;
+}
+
+/*
+ * Cells N, W, E and S of each cell, ie in ascending order,
+ * which are the cells a tile can slide from into the blank.
+ */
+void print_neighbours(void)
+{
+  int cell, y, x, count[YS * XS], i ;
+  int next[YS * XS][MOVE_DIRECTIONS] ;
+
+  for(cell = 0 ; cell < YS * XS ; cell++){
+    y = cell / XS ;
+    x = cell % XS ;
+    count[cell] = 0 ;
+
+    for(i = 0 ; i < MOVE_DIRECTIONS ; i++){
+      next[cell][i] = 0 ;
+    }
+
+    if(y > 0){
+      next[cell][count[cell]++] = cell - XS ;
+    }
+    if(x > 0){
+      next[cell][count[cell]++] = cell - 1 ;
+    }
+    if(x < XS - 1){
+      next[cell][count[cell]++] = cell + 1 ;
+    }
+    if(y < YS - 1){
+      next[cell][count[cell]++] = cell + XS ;
+    }
+  }
+
+  printf("/* Number of cells next to each cell. */\n") ;
+  printf("static const int neighbour_count[%d] = ", YS * XS) ;
+  print_row(count, YS * XS, " ;\n\n") ;
+
+  printf("/* Cells next to each cell, in ascending order. */\n") ;
+  printf("static const int neighbour[%d][%d] = {\n", YS * XS, \
+  MOVE_DIRECTIONS) ;
+
+  for(cell = 0 ; cell < YS * XS ; cell++){
+    print_row(next[cell], MOVE_DIRECTIONS, \
+    (cell == (YS * XS) - 1) ? "\n" : ",\n") ;
+  }
+
+  printf("} ;\n") ;
+
+  return ;
+}
+
+/* Prints one row of a table, ie {a, b, ...}, then end. */
+void print_row(int *row, int length, char *end)
+{
+  int i ;
+
+  printf("{") ;
+
+  for(i = 0 ; i < length ; i++){
+    printf("%s%d", (i == 0) ? "" : ", ", *(row + i)) ;
+  }
+
+  printf("}%s", end) ;
+
+  return ;
+}
@@ -0,0 +1,126 @@
+/*
+ * Header including the ranking functions for 8-tile. Each
+ * board is a permutation of the 9 tiles, so its Lehmer code
+ * maps it to a unique integer in [0, 9!), which is used to
+ * index a visited bitmap.
+ */
+#include <stdlib.h>
+
+#define VISITED_MEMORY_ERROR "\nERROR: Unable to allocate " \
+"space for the visited bitmap.\n\n"
+
+/*
+ * Digit of each cell in the permutation is the code of its
+ * tile in the packed board, so the solution is the identity
+ * permutation and has rank 0.
+ */
+#define SOLUTION_RANK 0
+
+/* Mask of every digit lower than d. */
+#define LOWER_DIGITS(d) ((1U << d) - 1)
+
+/* Weight of each place in the Lehmer code, ie (8 - i)!. */
+#define PLACE_VALUES {40320, 5040, 720, 120, 24, 6, 2, 1, 1}
+
+/* One bit per board, ie 9! / 8 = 45360 bytes. */
+#define VISITED_BYTES (Q_MAX / 8)
+#define IS_VISITED(v, r) (v[r >> 3] & (1 << (r & 7)))
+#define MARK_VISITED(v, r) (v[r >> 3] |= (1 << (r & 7)))
+
+/*
+ * Marks board r visited, returning whether it already was,
+ * as one atomic test-and-set, so that threads sharing the
+ * bitmap never both add the same board.
+ */
+#define TEST_AND_MARK(v, r) (__atomic_fetch_or(&v[r >> 3], \
+(unsigned char)(1 << (r & 7)), __ATOMIC_RELAXED) & (1 << (r & 7)))
+
+unsigned char *create_visited(void) ;
+unsigned long board_rank(Packed board) ;
+Packed rank_to_board(unsigned long rank) ;
+unsigned int count_bits(unsigned int bits) ;
+
+
+/* Empty bitmap, ie no board has been visited as of yet. */
+unsigned char *create_visited(void)
+{
+  unsigned char *visited ;
+
+  visited = (unsigned char *)calloc(VISITED_BYTES, \
+  sizeof(unsigned char)) ;
+
+  if(visited == NULL){
+    fprintf(stderr, VISITED_MEMORY_ERROR) ;
+    exit(EXIT_FAILURE) ;
+  }
+
+  return visited ;
+}
+
+/* Lehmer code of board, using a bitmask of used digits. */
+unsigned long board_rank(Packed board)
+{
+  static const unsigned long place[NUM_TILES] = \
+  PLACE_VALUES ;
+  unsigned long rank ;
+  unsigned int used, digit ;
+  int i ;
+
+  rank = 0 ;
+  used = 0 ;
+
+  /* Last place is always 0, so can be skipped. */
+  for(i = 0 ; i < NUM_WO_BLANK ; i++){
+    digit = CELL(board, i) ;
+
+    /* Number of smaller digits that are still unused. */
+    rank += (digit - count_bits(used & LOWER_DIGITS(digit))) \
+    * place[i] ;
+
+    used |= (1U << digit) ;
+  }
+
+  return rank ;
+}
+
+/* Inverse of board_rank - the board with the given rank. */
+Packed rank_to_board(unsigned long rank)
+{
+  static const unsigned long place[NUM_TILES] = \
+  PLACE_VALUES ;
+  unsigned int unused, digit, skip ;
+  Packed board ;
+  int i ;
+
+  unused = LOWER_DIGITS(NUM_TILES) ;
+  board = 0 ;
+
+  for(i = 0 ; i < NUM_TILES ; i++){
+    skip = rank / place[i] ;
+    rank %= place[i] ;
+
+    /* Find the unused digit with skip unused below it. */
+    for(digit = 0 ; (skip > 0) || !(unused & (1U << digit)) ; \
+    digit++){
+      if(unused & (1U << digit)){
+        skip-- ;
+      }
+    }
+
+    board |= (Packed)digit << (i * CELL_BITS) ;
+
+    unused &= ~(1U << digit) ;
+  }
+
+  return board ;
+}
+
+/* Population count of a word (no compiler builtins). */
+unsigned int count_bits(unsigned int bits)
+{
+  bits = bits - ((bits >> 1) & 0x55555555U) ;
+  bits = (bits & 0x33333333U) + ((bits >> 2) & 0x33333333U) ;
+  bits = (bits + (bits >> 4)) & 0x0F0F0F0FU ;
+
+  return (bits * 0x01010101U) >> 24 ;
+}
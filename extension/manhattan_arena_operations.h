@@ -0,0 +1,139 @@
+/*
+ * Header including the arena that holds every board created
+ * by the extension of 8-tile. Boards are stored in fixed
+ * size chunks, so they never move once created, and are
+ * addressed by their index (order of creation), giving O(1)
+ * access to any board.
+ */
+#include <stdlib.h>
+#include "manhattan_board_operations.h"
+
+/* Each chunk holds 2^12 = 4096 boards. */
+#define CHUNK_SHIFT 12
+#define CHUNK_SIZE (1 << CHUNK_SHIFT)
+#define CHUNK_MASK (CHUNK_SIZE - 1)
+
+/* Initial number of chunks the arena has room for. */
+#define CHUNKS_START 16
+
+/* Returned by new_board when there is no room for a board. */
+#define ARENA_FULL -1
+
+/* Board at index i of the arena. */
+#define NODE(arena, i) \
+(&(arena)->chunk[(i) >> CHUNK_SHIFT][(i) & CHUNK_MASK])
+
+/*
+ * Puzzle: data structure used throughout program. Conflict,
+ * inversions, pattern (database moves, and the parts of it
+ * from each table) and walk (the counts of each row and
+ * column) are only kept for the heuristics that use them
+ * (see manhattan_heuristic_operations.h), and are short as
+ * every board in the arena holds them.
+ */
+struct puzzle{
+  Packed board ;
+  int parent ;
+  int blank ;
+  int last_blank ;
+  int moves ;
+  int distance ;
+  int manhattan ;
+  short conflict ;
+  short row_inversions ;
+  short column_inversions ;
+  short pattern ;
+  short row_walk ;
+  short column_walk ;
+  Packed parts ;
+} ;
+typedef struct puzzle Puzzle ;
+
+/* Arena: every board, in the order they were created. */
+struct arena{
+  Puzzle **chunk ;
+  int chunks ;
+  int size ;
+  int count ;
+} ;
+typedef struct arena Arena ;
+
+INTERNAL int create_arena(Arena *arena) ;
+INTERNAL int new_board(Arena *arena) ;
+INTERNAL void reset_arena(Arena *arena) ;
+INTERNAL void free_arena(Arena *arena) ;
+
+
+/* Arena starts empty, with room for the chunk pointers. */
+INTERNAL int create_arena(Arena *arena)
+{
+  arena->chunks = 0 ;
+  arena->size = CHUNKS_START ;
+  arena->count = 0 ;
+
+  arena->chunk = (Puzzle **)malloc(CHUNKS_START * \
+  sizeof(Puzzle *)) ;
+
+  return (arena->chunk == NULL) ? SOLVER_MEMORY_ERROR : \
+  SOLVER_OK ;
+}
+
+/*
+ * Reserves space for one more board, returns its index, or
+ * ARENA_FULL (the arena is left as it was).
+ */
+INTERNAL int new_board(Arena *arena)
+{
+  Puzzle **chunk ;
+
+  /* Only need a new chunk when the last one is full. */
+  if(arena->count == (arena->chunks << CHUNK_SHIFT)){
+    if(arena->chunks == arena->size){
+      chunk = (Puzzle **)realloc(arena->chunk, \
+      2 * arena->size * sizeof(Puzzle *)) ;
+
+      if(chunk == NULL){
+        return ARENA_FULL ;
+      }
+
+      arena->chunk = chunk ;
+      arena->size *= 2 ;
+    }
+
+    arena->chunk[arena->chunks] = (Puzzle *)malloc( \
+    CHUNK_SIZE * sizeof(Puzzle)) ;
+
+    if(arena->chunk[arena->chunks] == NULL){
+      return ARENA_FULL ;
+    }
+
+    arena->chunks++ ;
+  }
+
+  return arena->count++ ;
+}
+
+/* Forgets every board, but keeps the chunks to be reused. */
+INTERNAL void reset_arena(Arena *arena)
+{
+  arena->count = 0 ;
+
+  return ;
+}
+
+/* Releases every board at once, chunk by chunk. */
+INTERNAL void free_arena(Arena *arena)
+{
+  int i ;
+
+  for(i = 0 ; i < arena->chunks ; i++){
+    free(arena->chunk[i]) ;
+  }
+
+  free(arena->chunk) ;
+
+  arena->chunk = NULL ;
+  arena->chunks = arena->size = arena->count = 0 ;
+
+  return ;
+}
@@ -0,0 +1,224 @@
+/*
+ * Header including the packed board used by the extension
+ * of 8-tile. Each cell is stored in 4 bits of a 64-bit word,
+ * cell 0 (top left) in the lowest 4 bits, so a board fits in
+ * a single integer and two boards are equal iff the words
+ * are. Boards are only converted to/from char[YS][XS] when
+ * read from file and when displayed.
+ */
+#include <stdint.h>
+
+/* Packed: 4 bits per cell, ie up to 16 cells per board. */
+typedef uint64_t Packed ;
+
+#define CELL_BITS 4
+#define CELL_MASK ((Packed)0xF)
+#define MAX_CELLS 16
+
+/* 
+ * Largest board whose every permutation can be ranked into
+ * a visited bitmap, ie 10! bits. Bigger boards use a hash set.
+ */
+#define RANK_CELLS 10
+
+#if (YS * XS) > MAX_CELLS
+#error "A board of more than 16 cells does not fit in a Packed."
+#endif
+#if (YS < 2) || (XS < 2)
+#error "A board needs at least two rows and two columns."
+#endif
+
+/*
+ * Code stored in each cell is the cell that the tile (or the
+ * blank) is in at the goal, so whatever the goal, it has code
+ * i in every cell i, ie the packed solution (which is in
+ * manhattan_tables.h). Hence, the tables only depend on the
+ * size of the board. For the usual goal, tiles '1' to '8' are
+ * 0 to 7 and the blank is 8 (on 3x3).
+ */
+#define TILE_NUMBER(c) ((c == BLANK) ? 0 : CHAR_TILE(c))
+
+/* Goal: the relabelling of tiles to codes for one goal. */
+struct goal{
+  int code[NUM_TILES] ;
+  char tile[NUM_TILES] ;
+  int blank ;
+} ;
+typedef struct goal Goal ;
+
+/* Code of the tile in cell i of a packed board. */
+#define CELL(board, i) \
+((int)((board >> ((i) * CELL_BITS)) & CELL_MASK))
+
+/*
+ * If the start and goal boards have the same parity of
+ * inversions, then puzzle solvable. For an even width, a
+ * move up or down changes the parity of the inversions, so
+ * the rows of the blank in both boards are added too.
+ */
+#define SOLVABLE_CHECK(inversions, blank_rows) \
+((((inversions) + (((XS % 2) == 0) ? (blank_rows) : 0)) \
+% 2) == 0)
+
+INTERNAL void make_goal(char *top_left, Goal *goal) ;
+INTERNAL void usual_goal(Goal *goal) ;
+INTERNAL Packed pack_board(char *top_left, Goal *goal) ;
+INTERNAL void unpack_board(Packed board, char *top_left, \
+Goal *goal) ;
+INTERNAL Packed slide_tile(Packed board, int tile, int blank) ;
+INTERNAL int valid_board(char *board) ;
+INTERNAL int solvable_board(char *first_board, \
+char *goal_board) ;
+INTERNAL int count_inversions(char *board, int *blank_row) ;
+
+
+/* 
+ * Code of each tile (by its number, the blank is 0) and the
+ * tile with each code, from a char board of the goal.
+ */
+INTERNAL void make_goal(char *top_left, Goal *goal)
+{
+  int i ;
+
+  for(i = 0 ; i < NUM_TILES ; i++){
+    goal->code[TILE_NUMBER(*(top_left + i))] = i ;
+
+    goal->tile[i] = *(top_left + i) ;
+
+    if(*(top_left + i) == BLANK){
+      goal->blank = i ;
+    }
+  }
+
+  return ;
+}
+
+/* Usual goal, tiles in order with the blank in last cell. */
+INTERNAL void usual_goal(Goal *goal)
+{
+  char top_left[NUM_TILES] ;
+  int i ;
+
+  for(i = 0 ; i < NUM_WO_BLANK ; i++){
+    top_left[i] = TILE_CHAR(i + 1) ;
+  }
+
+  top_left[NUM_WO_BLANK] = BLANK ;
+
+  make_goal(top_left, goal) ;
+
+  return ;
+}
+
+/* Packs a char board (from file) into a single word. */
+INTERNAL Packed pack_board(char *top_left, Goal *goal)
+{
+  Packed board ;
+  int i ;
+
+  board = 0 ;
+
+  for(i = 0 ; i < NUM_TILES ; i++){
+    board |= (Packed)goal->code[TILE_NUMBER(*(top_left + i))] \
+    << (i * CELL_BITS) ;
+  }
+
+  return board ;
+}
+
+/* Unpacks a board into char form, ready to be displayed. */
+INTERNAL void unpack_board(Packed board, char *top_left, \
+Goal *goal)
+{
+  int i, code ;
+
+  for(i = 0 ; i < NUM_TILES ; i++){
+    code = CELL(board, i) ;
+
+    *(top_left + i) = goal->tile[code] ;
+  }
+
+  return ;
+}
+
+/*
+ * Slides the tile in cell tile into the blank cell. XOR of
+ * the codes of the tile and the blank (which depends on the
+ * goal) swaps the two in each cell.
+ */
+INTERNAL Packed slide_tile(Packed board, int tile, int blank)
+{
+  Packed swap ;
+
+  swap = (Packed)(CELL(board, tile) ^ CELL(board, blank)) ;
+
+  return board ^ (swap << (tile * CELL_BITS)) ^ \
+  (swap << (blank * CELL_BITS)) ;
+}
+
+/* Board has exactly one of each tile, and one blank. */
+INTERNAL int valid_board(char *board)
+{
+  int i, tile, seen[NUM_TILES] = {0} ;
+
+  for(i = 0 ; i < NUM_TILES ; i++){
+    if((board[i] != BLANK) && (!TILE_CHAR_CHECK(board[i]) || \
+    (CHAR_TILE(board[i]) > NUM_WO_BLANK))){
+      return 0 ;
+    }
+
+    tile = TILE_NUMBER(board[i]) ;
+
+    if(seen[tile]++){
+      return 0 ;
+    }
+  }
+
+  return 1 ;
+}
+
+/* Board solvable iff the parities of both boards match. */
+INTERNAL int solvable_board(char *first_board, char *goal_board)
+{
+  int inversions, first_row, goal_row ;
+
+  /* Only the parity of each total matters, so add both. */
+  inversions = count_inversions(first_board, &first_row) + \
+  count_inversions(goal_board, &goal_row) ;
+
+  return SOLVABLE_CHECK(inversions, first_row + goal_row) ;
+}
+
+/* Total num. of inversions of board, and row of its blank.*/
+INTERNAL int count_inversions(char *board, int *blank_row)
+{
+  int i, j, inversions ;
+  char linear[NUM_WO_BLANK] ;
+
+  inversions = 0 ;
+  *blank_row = 0 ;
+  j = 0 ;
+
+  /* 1D array filled (in order) with non-space characters.*/
+  for(i = 0 ; i < NUM_TILES ; i++){
+    if(*(board + i) != BLANK){
+      linear[j] = *(board + i) ;
+      j++ ;
+    }
+
+    else{
+      *blank_row = i / XS ;
+    }
+  }
+
+  /* Calculates and totals num. of inversions for tile. */
+  for(i = 0 ; i < NUM_WO_BLANK ; i++){
+    for(j = i + 1 ; j < NUM_WO_BLANK; j++){
+      if(linear[i] > linear[j]){
+        inversions++ ;
+      }
+    }
+  }
+
+  return inversions ;
+}
@@ -0,0 +1,234 @@
+/*
+ * Compresses a pattern database made by manhattan_make_pdb.c
+ * (see manhattan_pdb_operations.h for the formats), and
+ * reports what it saves against what it loses: the size of
+ * the table before and after, and the mean of the moves it
+ * gives over every entry (the more of them, the fewer boards
+ * a search expands) before and after.
+ */
+#define _POSIX_C_SOURCE 200112L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "manhattan_file_operations.h"
+#include "manhattan_board_operations.h"
+#include "manhattan_tables.h"
+#include "manhattan_pdb_operations.h"
+
+#define COMPRESS_ARGS_ERROR "\nERROR: Unexpected input.\n" \
+"Please try something like: %s nibbles 4 in.bin out.bin\n" \
+"(format bytes, nibbles or mod3, then k, to keep the least " \
+"of every k entries, 1 for mod3)\n\n"
+#define COMPRESS_INPUT_ERROR "\nERROR: Only a table of the " \
+"exact moves, a byte per entry, can be compressed.\n\n"
+#define COMPRESS_MEMORY_ERROR "\nERROR: Unable to allocate " \
+"space for the compressed table.\n\n"
+
+/* Names of the formats, in order. */
+#define FORMATS 3
+static const char *format_name[FORMATS] = {"bytes", "nibbles", \
+"mod3"} ;
+
+void compress_pdb(Pdb *in, Pdb *out, unsigned char *table) ;
+int compress_value(Pdb *out, int moves, int *cell) ;
+void store_value(Pdb *out, unsigned char *table, long place, \
+int value) ;
+void report_pdb(Pdb *in, Pdb *out, unsigned char *table, \
+char *file) ;
+
+
+int main(int argc, char *argv[])
+{
+  Pdb in, out ;
+  unsigned char *table ;
+  int format, status ;
+
+  for(format = 0 ; (argc == 5) && (format < FORMATS) && \
+  (strcmp(argv[1], format_name[format]) != 0) ; format++) ;
+
+  if((argc != 5) || (format == FORMATS) || (atoi(argv[2]) < 1) \
+  || ((format == PDB_MOD3) && (atoi(argv[2]) != 1))){
+    fprintf(stderr, COMPRESS_ARGS_ERROR, argv[0]) ;
+    exit(EXIT_FAILURE) ;
+  }
+
+  if((status = load_pdb(&in, argv[3])) != SOLVER_OK){
+    fprintf(stderr, pdb_message(status), argv[3]) ;
+    exit(EXIT_FAILURE) ;
+  }
+
+  if((in.format != PDB_BYTES) || (in.group != 1) || !in.exact){
+    fprintf(stderr, COMPRESS_INPUT_ERROR) ;
+    exit(EXIT_FAILURE) ;
+  }
+
+  out = in ;
+  out.format = format ;
+  out.group = atoi(argv[2]) ;
+  out.exact = 1 ;
+
+  pdb_places(&out) ;
+
+  table = (unsigned char *)calloc(pdb_bytes(&out), \
+  sizeof(unsigned char)) ;
+
+  if(table == NULL){
+    fprintf(stderr, COMPRESS_MEMORY_ERROR) ;
+    exit(EXIT_FAILURE) ;
+  }
+
+  compress_pdb(&in, &out, table) ;
+
+  report_pdb(&in, &out, table, argv[3]) ;
+
+  status = save_pdb(&out, table, argv[4]) ;
+
+  free(table) ;
+
+  munmap(in.map, in.size) ;
+
+  if(status != SOLVER_OK){
+    fprintf(stderr, pdb_message(status), argv[4]) ;
+    exit(EXIT_FAILURE) ;
+  }
+
+  return 0 ;
+}
+
+/*
+ * Keeps the least value of each group of entries (next to
+ * each other, so the last tiles of the pattern differ). Out
+ * is only exact if no value is ever lost.
+ */
+void compress_pdb(Pdb *in, Pdb *out, unsigned char *table)
+{
+  long index ;
+  int value, least, cell[MAX_CELLS] ;
+
+  least = 0 ;
+
+  for(index = 0 ; index < in->entries ; index++){
+    pdb_cells(in, index, cell) ;
+
+    value = compress_value(out, in->table[index], cell) ;
+
+    if(index % out->group == 0){
+      least = value ;
+    }
+
+    /* Any entry not the least of its group loses moves. */
+    else if(value != least){
+      out->exact = 0 ;
+      least = (value < least) ? value : least ;
+    }
+
+    if((index % out->group == out->group - 1) || \
+    (index == in->entries - 1)){
+      store_value(out, table, index / out->group, least) ;
+    }
+  }
+
+  return ;
+}
+
+/*
+ * Value kept for the pattern's tiles in cell, moves from the
+ * goal: half the moves over their Manhattan distance (which
+ * has the same parity, as each move changes it by one) for
+ * nibbles, or the moves modulo 3.
+ */
+int compress_value(Pdb *out, int moves, int *cell)
+{
+  int value ;
+
+  if(out->format == PDB_NIBBLES){
+    value = (moves - pdb_manhattan(out, cell)) / 2 ;
+
+    if(value > NIBBLE_LIMIT){
+      out->exact = 0 ;
+      value = NIBBLE_LIMIT ;
+    }
+
+    return value ;
+  }
+
+  if(out->format == PDB_MOD3){
+    return moves % 3 ;
+  }
+
+  return moves ;
+}
+
+/* Packs value into table, as value place of those kept. */
+void store_value(Pdb *out, unsigned char *table, long place, \
+int value)
+{
+  if(out->format == PDB_NIBBLES){
+    table[place >> 1] |= (unsigned char)(value << \
+    ((place & 1) << 2)) ;
+  }
+
+  else if(out->format == PDB_MOD3){
+    table[place >> 2] |= (unsigned char)(value << \
+    ((place & 3) << 1)) ;
+  }
+
+  else{
+    table[place] = (unsigned char)value ;
+  }
+
+  return ;
+}
+
+/*
+ * Size of the table, and mean moves over every entry, before
+ * and after. Moves modulo 3 are exact once the moves before
+ * are known, so lose nothing.
+ */
+void report_pdb(Pdb *in, Pdb *out, unsigned char *table, \
+char *file)
+{
+  Pdb kept ;
+  long index, exact ;
+  double before, after ;
+  int moves, cell[MAX_CELLS] ;
+
+  kept = *out ;
+  kept.table = table ;
+
+  before = after = 0.0 ;
+  exact = 0 ;
+
+  for(index = 0 ; index < in->entries ; index++){
+    moves = in->table[index] ;
+    before += moves ;
+
+    if(out->format != PDB_MOD3){
+      pdb_cells(in, index, cell) ;
+      moves = pdb_decode(&kept, cell, 0) ;
+    }
+
+    after += moves ;
+    exact += (moves == in->table[index]) ;
+  }
+
+  printf("Table:      %s (%d tiles, %ld entries)\n", file, \
+  in->tiles, in->entries) ;
+
+  printf("Format:     %s, least of every %d %s\n", \
+  format_name[out->format], out->group, \
+  (out->group == 1) ? "entry" : "entries") ;
+
+  printf("Size:       %ld to %ld bytes (%.1f times smaller)\n", \
+  (long)in->size, (long)(PDB_HEADER_BYTES + pdb_bytes(out)), \
+  (double)in->size / (PDB_HEADER_BYTES + pdb_bytes(out))) ;
+
+  printf("Mean moves: %.3f to %.3f (%.1f%%)\n", \
+  before / in->entries, after / in->entries, \
+  (100.0 * after) / before) ;
+
+  printf("Exact:      %.1f%% of entries\n", \
+  (100.0 * exact) / in->entries) ;
+
+  return ;
+}
@@ -1,28 +1,25 @@
 /* 
  * Header file including all display/print related functions
- * for extension of 8-tile. The linked data structure, 
- * Puzzle, is defined on line 74 (updated for Manhattan). 
+ * for extension of 8-tile. The boards of a solution come
+ * from the solver library (see manhattan_solver.h), as a
+ * path of NUM_TILES chars per board, from the start. 
  */
 #include <stdlib.h>
+#include <string.h>
 #include "manhattan_large_numbers.h"
 #include "neillncurses.h"
+#include "manhattan_internal.h"
 
 /* Errors related to the creation of the display. */ 
 #define DISPLAY_ERROR "\nERROR: Unexpected tile position " \
 "input when creating large display.\n\n"
 #define ENLARGE_ERROR "\nERROR: Unexpected tile input " \
 "when enlarging the array for moving display.\n\n"
-
-/* The maximum numbers of moves is 9! = 362880. */ 
-#define Q_MAX 362880
-
-/* Solution is located at place (counter - 1) in queue. */  
-#define SOLUTION_PLACE(counter) (counter - 1)
-
-#define ROOT_NODE -1
-
-/* As starting board is printed, num. moves is one less. */ 
-#define MOVES(prints) (prints - 1)
+/* 
+ * Most boards in a displayed solution. The longest solution
+ * is 31 moves for 3x3 and 80 for 4x4 (see F_LIMIT).
+ */ 
+#define MAX_STEPS 256
 
 /* Array starts at [0], therefore +1 needed to reach XS. */ 
 #define END_OF_ROW(i) (i + 1)
@@ -70,132 +67,90 @@
 #define MDL 1
 #define BTM 2
 
-/* Puzzle: Dynamic data structure used throughout program.*/
-struct puzzle{
-  char board[YS][XS] ;
-  int parent ;
-  int moves ; 
-  int manhattan ; 
-  struct puzzle *next ; 
-} ;
-typedef struct puzzle Puzzle ;
-
-void display_solution(Puzzle *start, int counter) ; 
-void sort_print_array(Puzzle *start, \
-int print_steps[Q_MAX], int counter, int *num) ;
-void record_of_solution(Puzzle *start, int *print_steps, \
-int steps) ; 
-void define_colour_scheme(NCURS_Simplewin *move) ; 
-void puzzle_introduction(NCURS_Simplewin *move, \
-Puzzle *start) ; 
-void make_array_big(char normal[YS][XS], \
+INTERNAL void display_solution(char *path, int moves, \
+Search_Stats *stats) ;
+INTERNAL void record_of_solution(char *path, int steps) ;
+INTERNAL void record_of_search(Search_Stats *stats) ; 
+INTERNAL void define_colour_scheme(NCURS_Simplewin *move) ; 
+INTERNAL void puzzle_introduction(NCURS_Simplewin *move, \
+char *start) ;
+INTERNAL void make_array_big(char normal[YS][XS], \
 char big[DISP_SIZE][DISP_SIZE]) ; 
-void solution_graphic(NCURS_Simplewin *move, \
-Puzzle *start, int print_steps[Q_MAX], int moves) ;
-void moving_display(NCURS_Simplewin *move, Puzzle *start, \
-int print_steps) ; 
-void determine_tile_position(int k, int *y, int *x) ;
-void determine_tile(char change[TILE_SIZE][TILE_SIZE], \
+INTERNAL void solution_graphic(NCURS_Simplewin *move, \
+char *path, int moves) ;
+INTERNAL void moving_display(NCURS_Simplewin *move, \
+char *board) ;
+INTERNAL void determine_tile_position(int k, int *y, int *x) ;
+INTERNAL void determine_tile(char change[TILE_SIZE][TILE_SIZE], \
 char tile) ; 
-void pointer_chase(Puzzle **start, Puzzle **location, \
-int displacement) ;
 
 
 /* Solution displayed with ncurses, with record of steps. */
-void display_solution(Puzzle *start, int counter)
+INTERNAL void display_solution(char *path, int moves, \
+Search_Stats *stats)
 {
   NCURS_Simplewin disp ;
-  int prints, *steps ;
-  
-  /* Ensure array big enough for largest number of moves. */
-  int print_steps[Q_MAX] = {0} ; 
-   
-  prints = 0 ; 
-  steps = &prints ;  
 
-  sort_print_array(start, print_steps, counter, steps) ;
-    
-  record_of_solution(start, print_steps, MOVES(prints)) ;
+  record_of_solution(path, moves) ;
 
-  Neill_NCURS_Init(&disp) ;
-    
-  define_colour_scheme(&disp) ;
-      
-  puzzle_introduction(&disp, start) ;
-  
-  solution_graphic(&disp, start, print_steps, \
-  MOVES(prints)) ; 
-   
-  return ; 
+  record_of_search(stats) ;
+
+  /* Large tile graphics are only drawn for 3x3 boards. */
+  if((YS == 3) && (XS == 3)){
+    Neill_NCURS_Init(&disp) ;
+
+    define_colour_scheme(&disp) ;
+
+    /* The starting board is always the first of the path. */
+    puzzle_introduction(&disp, path) ;
+
+    solution_graphic(&disp, path, moves) ;
+  }
+
+  return ;
 }
 
-/* Fills array with each correct board location in queue. */ 
-void sort_print_array(Puzzle *start, \
-int print_steps[Q_MAX], int counter, int *steps)
+/* Print record of steps to solution for the user. */
+INTERNAL void record_of_solution(char *path, int steps)
 {
-  Puzzle *position ; 
+  char *board ;
   int i, j ;
-  
-  i = 0 ; 
-  j = SOLUTION_PLACE(counter) ; 
-  
-  /* Fills print_steps array by tracing back from sol. */ 
-  do{
-    /* Fill array with parent's position in queue. */ 
-    print_steps[i] = j ;
-    
-    /* Pointer chase to parent board location in queue. */ 
-    pointer_chase(&start, &position, j) ; 
-    
-    j = position->parent ;
-     
-    /* Counter the number of steps  to reach solution. */
-    (*steps)++ ;
-    
-    /* Walk through array, as many times a needed. */ 
-    i++ ;
-  } while(j != ROOT_NODE) ; 
-    
-  return ; 
-}
 
-/* Print record of steps to solution for the user. */  
-void record_of_solution(Puzzle *start, int *print_steps, \
-int steps) 
-{
-  Puzzle *print ;
-  char *top_left ;  
-  int i, j, track ; 
-  
-  track = 0 ; 
-  
-  for(j = steps ; j >= 0 ; j--){
-    printf("\nBoard number %d:\n", track) ; 
-    
-    pointer_chase(&start, &print, *(print_steps + j)) ; 
+  for(j = 0 ; j <= steps ; j++){
+    printf("\nBoard number %d:\n", j) ;
 
-    top_left = &print->board[0][0] ;
-    
-    /* Print board. */ 
+    board = path + (j * NUM_TILES) ;
+
+    /* Print board. */
     for(i = 0 ; i < NUM_TILES ; i++){
-    
-      printf("%c ", *(top_left + i)) ;
-      
+
+      printf("%c ", *(board + i)) ;
+
       if((END_OF_ROW(i) % XS) == 0){
-        printf("\n") ; 
+        printf("\n") ;
       }
     }
-    
-    track++ ; 
   }
-  
+
   printf("\nTotal number of moves in solution: %d\n\n", \
-  steps) ; 
+  steps) ;
+
+  return ;
+}
+
+/* Print how much work the search did to find solution. */
+INTERNAL void record_of_search(Search_Stats *stats)
+{
+  printf("Boards expanded: %ld\n", stats->expanded) ; 
+  
+  printf("Boards generated: %ld\n", stats->generated) ; 
+  
+  printf("Moves pruned: %ld\n\n", stats->pruned) ; 
   
   return ; 
 }
 
-void define_colour_scheme(NCURS_Simplewin *move)
+INTERNAL void define_colour_scheme(NCURS_Simplewin *move)
 {
   /*
    * Defines the text and background colour in display:
@@ -223,16 +178,18 @@ void define_colour_scheme(NCURS_Simplewin *move)
 }
 
 /* Introduces the puzzle to the user before it is solved. */ 
-void puzzle_introduction(NCURS_Simplewin *move, \
-Puzzle *start) 
+INTERNAL void puzzle_introduction(NCURS_Simplewin *move, \
+char *start)
 {
   char intro_1[LNGTH1] = INTRO1 ;
   char intro_2[LNGTH2] = INTRO2 ; 
   char intro_3[LNGTH3] = INTRO3 ;
-  char big[DISP_SIZE][DISP_SIZE] ; 
+  char big[DISP_SIZE][DISP_SIZE], normal[YS][XS] ; 
+  
+  memcpy(&normal[0][0], start, NUM_TILES) ;
   
   /* Enlarges arrays to make display easier to read. */ 
-  make_array_big(start->board, big) ; 
+  make_array_big(normal, big) ; 
   
   /* Display array to screen, state length and height. */
   Neill_NCURS_PrintArray(intro_1, LNGTH1, L_HEIGHT, move) ;
@@ -259,7 +216,7 @@ Puzzle *start)
 }
 
 /* Creates a large array from each board for display. */
-void make_array_big(char normal[YS][XS], \
+INTERNAL void make_array_big(char normal[YS][XS], \
 char big[DISP_SIZE][DISP_SIZE])
 {
   unsigned short i, j, k ;
@@ -297,7 +254,7 @@ char big[DISP_SIZE][DISP_SIZE])
 }
 
 /* Determines the location of each tile on large board. */ 
-void determine_tile_position(int k, int *y, int *x)
+INTERNAL void determine_tile_position(int k, int *y, int *x)
 {
   int i, third ; 
   
@@ -329,7 +286,7 @@ void determine_tile_position(int k, int *y, int *x)
 }
 
 /* Fills 2D array with large graphic the inputted tile. */
-void determine_tile(char change[TILE_SIZE][TILE_SIZE], \
+INTERNAL void determine_tile(char change[TILE_SIZE][TILE_SIZE], \
 char tile) 
 {
   /* Predefine large number graphics for each tile. */ 
@@ -378,41 +335,39 @@ char tile)
 }
 
 /* Animated step-by-step guide to the solution. */ 
-void solution_graphic(NCURS_Simplewin *move, \
-Puzzle *start, int print_steps[Q_MAX], int moves)
+INTERNAL void solution_graphic(NCURS_Simplewin *move, \
+char *path, int moves)
 {
   int i ;
-  
-  i = moves ;
-  
-  while((!move->finished) && (i >= 0)){
-  
-    moving_display(move, start, print_steps[i]) ;
-     
-    Neill_NCURS_Delay(ONE_SECOND) ; 
-    
+
+  i = 0 ;
+
+  while((!move->finished) && (i <= moves)){
+
+    moving_display(move, path + (i * NUM_TILES)) ;
+
+    Neill_NCURS_Delay(ONE_SECOND) ;
+
     /* Wait for mouse click, or ESC, to finish loop. */
-    Neill_NCURS_Events(move) ; 
-    
-    i-- ; 
-  } 
+    Neill_NCURS_Events(move) ;
 
-  return ; 
+    i++ ;
+  }
+
+  return ;
 }
 
 /* Large visualisation of current the board for each step.*/
-void moving_display(NCURS_Simplewin *move, Puzzle *start, \
-int print_steps)
-{ 
-  Puzzle *position ; 
-  char big[DISP_SIZE][DISP_SIZE] ; 
-    
-  pointer_chase(&start, &position, print_steps) ; 
-  
-  make_array_big(position->board, big) ; 
-  
+INTERNAL void moving_display(NCURS_Simplewin *move, char *board)
+{
+  char big[DISP_SIZE][DISP_SIZE], normal[YS][XS] ;
+
+  memcpy(&normal[0][0], board, NUM_TILES) ;
+
+  make_array_big(normal, big) ;
+
   Neill_NCURS_PrintArray(&big[0][0], DISP_SIZE, DISP_SIZE, \
   move) ;
 
-  return ;  
+  return ;
 }
@@ -0,0 +1,47 @@
+/*
+ * Header including the Manhattan distance functions for the
+ * extension of 8-tile. The distance of every tile from its
+ * correct position is held in a table (manhattan_tables.h),
+ * indexed by the code of the tile and the cell it is in, so
+ * that when a tile slides only its own change in distance
+ * need be added. As a code is the cell the tile is in at the
+ * goal, the tables serve every goal.
+ */
+#include <stdlib.h>
+
+#define MANHATTAN_CHECK_ERROR "\nERROR: Manhattan distance " \
+"of board does not match the full recalculation.\n\n"
+
+INTERNAL int manhattan_function(Packed board, int blank, \
+int moves) ;
+
+
+/* Manhattan priority function determines place in queue. */
+INTERNAL int manhattan_function(Packed board, int blank, \
+int moves)
+{
+  int i, j, code, manhattan_number ;
+
+  manhattan_number = 0 ;
+  /*
+   * For all non-blank tiles, sum the absolute values of
+   * the coordinate distances (j, i) of each tile in their
+   * current position and their correct position, which
+   * is looked up in manhattan_tables.h.
+   */
+  for(j = 0 ; j < YS ; j++){
+    for(i = 0 ; i < XS ; i++){
+      code = CELL(board, (j * XS) + i) ;
+
+      if((j * XS) + i != blank){
+        manhattan_number += (abs(goal_y[code] - j) + \
+        abs(goal_x[code] - i)) ;
+      }
+    }
+  }
+
+  /* Add the number of moves already made get Manhatn. no.*/
+  manhattan_number += moves ;
+
+  return manhattan_number ;
+}
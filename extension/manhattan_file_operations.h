@@ -1,8 +1,11 @@
 /* 
  * Header file including all file related functions for the 
- * extension part of 8-tile. Includes new solvability check. 
+ * extension part of 8-tile. The board size is given by the
+ * solver library (see manhattan_internal.h), which checks
+ * the board is solvable.
  */
 #include <stdlib.h>
+#include "manhattan_internal.h"
 
 /* Errors messages related to file operations abd content.*/
 #define ERROR_OPENING_FILE "\nERROR: Cannot open file: " \
@@ -11,23 +14,21 @@
 "representing a board tile found in file.\n"
 #define DUPLICATE_MISSING_CHAR_ERROR "\nERROR: There " \
 "should be exactly one tile of each kind in the board.\n" \
-"Ie, only one of the following: ' ', '1', '2', '3', '4', " \
-"'5', '6','7', '8'.\n\n"
+"Ie, only one blank ' ' and one of each tile '1' to '%c' " \
+"(after '9' the tiles are 'A', 'B', ...).\n\n"
 #define ERROR_CLOSING_FILE "\nERROR: Cannot close file: "\
 "%s.\nPlease try again.\n\n"
-#define UNSOLVABLE_BOARD_ERROR "\nERROR: Unfortunately, " \
-"this board is unsolvable :(\nTry another!\n\n"
 
-/* Height, width and total number of tiles. */
-#define YS 3
-#define XS 3
-#define NUM_TILES (YS * XS)
-
-/* Total number of tiles not including the blank tile. */
-#define NUM_WO_BLANK (NUM_TILES - 1)
+/* 
+ * In a list of boards (one per line), the blank may also be
+ * written as '0', so that it is not lost at the end of line.
+ */
+#define LINE_BLANK '0'
 
-/* Blank tile defined as space character. */ 
-#define BLANK ' ' 
+/* Returned when reading each line of a list of boards. */
+#define LINE_VALID 1
+#define LINE_INVALID 0
+#define LINE_EMPTY 2
 
 /* Ignore EOF, newline and return characters in file! */ 
 #define IGNORED_CHAR(c) ((c == EOF) || (c == '\n') \
@@ -35,14 +36,6 @@
 
 /* Char and number representations used to check file. */ 
 #define TILE_BLANK 0
-#define TILE_1 1
-#define TILE_2 2
-#define TILE_3 3
-#define TILE_4 4
-#define TILE_5 5
-#define TILE_6 6
-#define TILE_7 7
-#define TILE_8 8
 #define CHAR_1 '1'
 #define CHAR_2 '2'
 #define CHAR_3 '3'
@@ -52,21 +45,18 @@
 #define CHAR_7 '7'
 #define CHAR_8 '8'
 
-/* If number of inversions is even, then puzzle solvable. */ 
-#define SOLVABLE_CHECK(inversions) (inversions % 2 == 0) 
-
-void open_file(FILE **et, char *argv) ; 
-void check_file_and_fill_first_board(FILE *et, \
+INTERNAL void open_file(FILE **et, char *argv) ; 
+INTERNAL void check_file_and_fill_first_board(FILE *et, \
 char *board, char *argv) ; 
-void characters_from_file_count(char c, \
+INTERNAL void characters_from_file_count(char c, \
 int correct_chars_check[NUM_TILES], FILE *et, char *argv) ; 
-void check_starting_board( \
+INTERNAL void check_starting_board( \
 int correct_chars_check[NUM_TILES], FILE *et, char *argv) ; 
-void close_file(FILE **et, char *argv) ;
-void solvable_board_check(char *first_board) ;  
+INTERNAL void close_file(FILE **et, char *argv) ;
+INTERNAL int board_from_line(FILE *list, char *board) ;
 
 
-void open_file(FILE **et, char *argv)
+INTERNAL void open_file(FILE **et, char *argv)
 { 
   if((*et = fopen(argv, "r")) == NULL){
     fprintf(stderr, ERROR_OPENING_FILE, argv) ; 
@@ -82,7 +72,7 @@ void open_file(FILE **et, char *argv)
 }
 
 /* Contains functions that check the validity of the file.*/
-void check_file_and_fill_first_board(FILE *et, \
+INTERNAL void check_file_and_fill_first_board(FILE *et, \
 char *board, char *argv)
 {
   int i ; 
@@ -98,7 +88,10 @@ char *board, char *argv)
       characters_from_file_count(c, correct_chars_check, \
       et, argv) ;
         
-      *(board + i) = c ; 
+      /* Extra chars are duplicates, so caught below. */
+      if(i < NUM_TILES){
+        *(board + i) = c ; 
+      }
       
       i++ ;  
     }
@@ -110,40 +103,40 @@ char *board, char *argv)
 }
 
 /* Totals the number of each 'correct' character in file. */
-void characters_from_file_count(char c, \
+INTERNAL void characters_from_file_count(char c, \
 int correct_chars_check[NUM_TILES], FILE *et, char *argv) 
 { 
-  switch(c){
-  case BLANK : correct_chars_check[TILE_BLANK]++ ; break ; 
-  case CHAR_1 : correct_chars_check[TILE_1]++ ; break ;
-  case CHAR_2 : correct_chars_check[TILE_2]++ ; break ;
-  case CHAR_3 : correct_chars_check[TILE_3]++ ; break ;
-  case CHAR_4 : correct_chars_check[TILE_4]++ ; break ;
-  case CHAR_5 : correct_chars_check[TILE_5]++ ; break ;
-  case CHAR_6 : correct_chars_check[TILE_6]++ ; break ;
-  case CHAR_7 : correct_chars_check[TILE_7]++ ; break ;
-  case CHAR_8 : correct_chars_check[TILE_8]++ ; break ;
+  if(c == BLANK){
+    correct_chars_check[TILE_BLANK]++ ; 
+  }
   
-  /* Default case is used to catch any incorrect chars. */
-  default :  fprintf(stderr, FILE_CONTENT_ERROR \
-  "Character: '%c' should not be in the file. Please " \
-  "remove and try again.\n\n", c) ;
-  close_file(&et, argv) ; 
-  exit(EXIT_FAILURE) ; 
+  else if(TILE_CHAR_CHECK(c) && \
+  (CHAR_TILE(c) <= NUM_WO_BLANK)){
+    correct_chars_check[CHAR_TILE(c)]++ ; 
+  }
+  
+  /* Final case is used to catch any incorrect chars. */
+  else{
+    fprintf(stderr, FILE_CONTENT_ERROR \
+    "Character: '%c' should not be in the file. Please " \
+    "remove and try again.\n\n", c) ;
+    close_file(&et, argv) ; 
+    exit(EXIT_FAILURE) ; 
   }
 
   return ; 
 }
 
 /* Ensures exactly one of each correct char in file. */
-void check_starting_board( \
+INTERNAL void check_starting_board( \
 int correct_chars_check[NUM_TILES], FILE *et, char *argv)
 {
   int i ; 
 
   for(i = 0 ; i < NUM_TILES ; i++){
     if(correct_chars_check[i] != 1){
-      fprintf(stderr, DUPLICATE_MISSING_CHAR_ERROR) ;
+      fprintf(stderr, DUPLICATE_MISSING_CHAR_ERROR, \
+      TILE_CHAR(NUM_WO_BLANK)) ;
       close_file(&et, argv) ; 
       exit(EXIT_FAILURE) ; 
     }
@@ -152,7 +145,7 @@ int correct_chars_check[NUM_TILES], FILE *et, char *argv)
   return ; 
 }
 
-void close_file(FILE **et, char *argv)
+INTERNAL void close_file(FILE **et, char *argv)
 {
   if(fclose(*et) != 0){
     fprintf(stderr, ERROR_CLOSING_FILE, argv) ;
@@ -167,40 +160,56 @@ void close_file(FILE **et, char *argv)
   return ; 
 }
 
-/* Checks if solvable using the total num. of inversions. */
-void solvable_board_check(char *first_board)
+/* 
+ * Reads the next line of a list into board. Unlike a board 
+ * file, a bad line does not exit, so returns LINE_INVALID,
+ * LINE_EMPTY (skipped) or LINE_VALID, or else EOF at end.
+ */
+INTERNAL int board_from_line(FILE *list, char *board)
 {
-  int i, j, inversions ; 
-  char linear[NUM_WO_BLANK] ;
+  int i, c, valid ; 
+  int correct_chars_check[NUM_TILES] = {0} ; 
   
-  inversions = 0 ; 
-  j = 0 ;   
+  i = 0 ; 
+  valid = 1 ; 
+  
+  while(((c = getc(list)) != EOF) && (c != '\n')){
+    if(c == '\r'){
+      continue ; 
+    }
     
-  /* 1D array filled (in order) with non-space characters.*/  
-  for(i = 0 ; i < NUM_TILES ; i++){
-    if(*(first_board + i) != BLANK){
-      linear[j] = *(first_board + i) ; 
-      j++ ;     
+    if(c == LINE_BLANK){
+      c = BLANK ; 
     }
-  }
-  
-  /* Calculates and totals num. of inversions for tile. */
-  for(i = 0 ; i < NUM_WO_BLANK ; i++){
-    for(j = i + 1 ; j < NUM_WO_BLANK; j++){
-      if(linear[i] > linear[j]){
-        inversions++ ; 
-      }
+    
+    if((i < NUM_TILES) && (c == BLANK)){
+      correct_chars_check[TILE_BLANK]++ ; 
+      *(board + i) = c ; 
+    }
+    
+    else if((i < NUM_TILES) && TILE_CHAR_CHECK(c) && \
+    (CHAR_TILE(c) <= NUM_WO_BLANK)){
+      correct_chars_check[CHAR_TILE(c)]++ ; 
+      *(board + i) = c ; 
+    }
+    
+    else{
+      valid = 0 ; 
     }
+    
+    i++ ; 
   }
-      
-  /* Board solvable iff total num. of inversions is even.*/    
-  if(SOLVABLE_CHECK(inversions)){
-    return ; 
+  
+  if(i == 0){
+    return (c == EOF) ? EOF : LINE_EMPTY ; 
   }
   
-  /* If num. inversions odd, warn user puzzle unsolvable. */
-  else{
-    fprintf(stderr, UNSOLVABLE_BOARD_ERROR) ; 
-    exit(EXIT_FAILURE) ; 
+  /* Exactly one of each correct char, as in a board file. */
+  for(i = 0 ; i < NUM_TILES ; i++){
+    if(correct_chars_check[i] != 1){
+      valid = 0 ; 
+    }
   }
+  
+  return valid ? LINE_VALID : LINE_INVALID ; 
 }
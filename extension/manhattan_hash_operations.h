@@ -0,0 +1,199 @@
+/*
+ * Header including the visited set for boards too big to be
+ * ranked (more than RANK_CELLS cells), eg the 15-puzzle, as
+ * a bitmap of 16! bits would not fit in memory. The packed
+ * boards are kept in an open addressing hash table instead,
+ * which is doubled in size whenever it is half full. Each
+ * slot is stamped with the search that filled it, so the
+ * table is emptied (for another search) by a new stamp.
+ */
+#include <stdlib.h>
+#include <string.h>
+
+/* Initial number of slots, ie 2^16. Always a power of 2. */
+#define HASH_START (1UL << 16)
+
+/* Slots with an older stamp are empty, 0 is never used. */
+#define FIRST_STAMP 1
+#define FILLED(v, i) ((v)->stamp[i] == (v)->search)
+
+/* Fibonacci hashing, ie 2^64 / golden ratio. */
+#define HASH_MULTIPLIER (((Packed)0x9E3779B9UL << 32) | \
+0x7F4A7C15UL)
+#define HASH(board, mask) \
+((unsigned long)(((board) * HASH_MULTIPLIER) >> 32) & (mask))
+
+/* Visited: every board marked so far, by its packed board. */
+struct visited{
+  Packed *slot ;
+  unsigned int *stamp ;
+  unsigned int search ;
+  unsigned long size ;
+  unsigned long count ;
+} ;
+typedef struct visited Visited ;
+
+INTERNAL Visited *create_visited(void) ;
+INTERNAL unsigned long find_slot(Visited *visited, \
+Packed board) ;
+INTERNAL int was_visited(Visited *visited, Packed board) ;
+INTERNAL int mark_visited(Visited *visited, Packed board) ;
+INTERNAL int grow_visited(Visited *visited) ;
+INTERNAL void clear_visited(Visited *visited, Arena *arena) ;
+INTERNAL void free_visited(Visited *visited) ;
+
+
+/* 
+ * Empty set, ie no board has been visited as of yet, or NULL
+ * if there is no room for it.
+ */
+INTERNAL Visited *create_visited(void)
+{
+  Visited *visited ;
+
+  visited = (Visited *)malloc(sizeof(Visited)) ;
+
+  if(visited == NULL){
+    return NULL ;
+  }
+
+  visited->slot = (Packed *)malloc(HASH_START * \
+  sizeof(Packed)) ;
+
+  visited->stamp = (unsigned int *)calloc(HASH_START, \
+  sizeof(unsigned int)) ;
+
+  if((visited->slot == NULL) || (visited->stamp == NULL)){
+    free_visited(visited) ;
+    return NULL ;
+  }
+
+  visited->search = FIRST_STAMP ;
+  visited->size = HASH_START ;
+  visited->count = 0 ;
+
+  return visited ;
+}
+
+/* Slot holding board, or else the empty slot it would use.*/
+INTERNAL unsigned long find_slot(Visited *visited, Packed board)
+{
+  unsigned long i ;
+
+  i = HASH(board, visited->size - 1) ;
+
+  /* Linear probing, the table is never more than half full.*/
+  while(FILLED(visited, i) && (visited->slot[i] != board)){
+    i = (i + 1) & (visited->size - 1) ;
+  }
+
+  return i ;
+}
+
+INTERNAL int was_visited(Visited *visited, Packed board)
+{
+  unsigned long i ;
+
+  i = find_slot(visited, board) ;
+
+  return FILLED(visited, i) ? 1 : 0 ;
+}
+
+INTERNAL int mark_visited(Visited *visited, Packed board)
+{
+  unsigned long i ;
+
+  i = find_slot(visited, board) ;
+
+  if(FILLED(visited, i)){
+    return SOLVER_OK ;
+  }
+
+  visited->slot[i] = board ;
+  visited->stamp[i] = visited->search ;
+  visited->count++ ;
+
+  if(visited->count * 2 > visited->size){
+    return grow_visited(visited) ;
+  }
+
+  return SOLVER_OK ;
+}
+
+/* 
+ * Doubles the table, moving every board to its new slot. If
+ * there is no room, the table is left as it was (so is more
+ * than half full, but still works).
+ */
+INTERNAL int grow_visited(Visited *visited)
+{
+  Visited old ;
+  unsigned long i, j ;
+
+  old = *visited ;
+
+  visited->size = old.size * 2 ;
+
+  visited->slot = (Packed *)malloc(visited->size * \
+  sizeof(Packed)) ;
+
+  visited->stamp = (unsigned int *)calloc(visited->size, \
+  sizeof(unsigned int)) ;
+
+  if((visited->slot == NULL) || (visited->stamp == NULL)){
+    free(visited->slot) ;
+    free(visited->stamp) ;
+    *visited = old ;
+    return SOLVER_MEMORY_ERROR ;
+  }
+
+  /* Stamps restart, as every old stamp has been dropped. */
+  visited->search = FIRST_STAMP ;
+
+  for(i = 0 ; i < old.size ; i++){
+    if(FILLED(&old, i)){
+      j = find_slot(visited, old.slot[i]) ;
+
+      visited->slot[j] = old.slot[i] ;
+      visited->stamp[j] = visited->search ;
+    }
+  }
+
+  free(old.slot) ;
+  free(old.stamp) ;
+
+  return SOLVER_OK ;
+}
+
+/*
+ * Empties the table, ready for another search, by moving to
+ * the next stamp. The arena is not needed (see the bitmap).
+ */
+INTERNAL void clear_visited(Visited *visited, Arena *arena)
+{
+  (void)arena ;
+
+  visited->search++ ;
+  visited->count = 0 ;
+
+  /* Stamps have wrapped round, so clear them once. */
+  if(visited->search == 0){
+    memset(visited->stamp, 0, visited->size * \
+    sizeof(unsigned int)) ;
+
+    visited->search = FIRST_STAMP ;
+  }
+
+  return ;
+}
+
+INTERNAL void free_visited(Visited *visited)
+{
+  free(visited->slot) ;
+
+  free(visited->stamp) ;
+
+  free(visited) ;
+
+  return ;
+}
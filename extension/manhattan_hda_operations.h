@@ -0,0 +1,416 @@
+/*
+ * Header including the parts of the parallel A* (HDA*) used
+ * by the extension of 8-tile. Each board is owned by one
+ * thread, chosen by a hash of the board, which alone keeps it
+ * in its open list and its table of best moves. Children are
+ * sent to their owner in messages, through a mailbox that any
+ * thread can post to without a lock.
+ */
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+/* Boards sent to a thread in one message. */
+#define MESSAGE_BOARDS 64
+
+/*
+ * Owner of a board, by the high bits of a multiplicative hash
+ * (a different multiplier to the table, so the boards of one
+ * owner still spread over its table).
+ */
+#define OWNER_MULTIPLIER (((Packed)0xC2B2AE3DUL << 32) | \
+0x27D4EB4FUL)
+#define HDA_OWNER(board, threads) \
+((int)((((board) * OWNER_MULTIPLIER) >> 32) % (threads)))
+
+/*
+ * Parent of a board may be in another thread's arena, so is
+ * its place in that arena times the number of threads, plus
+ * the thread it is in.
+ */
+#define HDA_PARENT(place, id, threads) \
+(((place) * (threads)) + (id))
+#define HDA_PLACE(parent, threads) ((parent) / (threads))
+#define HDA_THREAD(parent, threads) ((parent) % (threads))
+
+/* Table: initial number of slots (a power of 2), no board. */
+#define CLOSED_START (1UL << 12)
+#define CLOSED_EMPTY ((Packed)0)
+#define CLOSED_NONE -1
+
+/* Fibonacci hashing, ie 2^64 / golden ratio. */
+#define CLOSED_MULTIPLIER (((Packed)0x9E3779B9UL << 32) | \
+0x7F4A7C15UL)
+#define CLOSED_HASH(board, mask) \
+((unsigned long)(((board) * CLOSED_MULTIPLIER) >> 32) & (mask))
+
+/* Message: some boards for one thread, and the next message.*/
+struct message{
+  struct message *next ;
+  int count ;
+  Puzzle board[MESSAGE_BOARDS] ;
+} ;
+typedef struct message Message ;
+
+/*
+ * Mailbox: a stack of messages, posted by any thread but only
+ * ever taken (all at once) by its owner, so needs no lock.
+ */
+struct mailbox{
+  Message *head ;
+} ;
+typedef struct mailbox Mailbox ;
+
+/*
+ * Closed: fewest moves each board has been reached in by
+ * this thread, by its packed board. No board packs to 0.
+ */
+struct closed{
+  Packed *slot ;
+  unsigned char *moves ;
+  unsigned long size ;
+  unsigned long count ;
+} ;
+typedef struct closed Closed ;
+
+/* Hda_Thread: what each thread searches with. */
+struct hda_thread{
+  Arena arena ;
+  Open_List *open ;
+  Closed closed ;
+  Mailbox mailbox ;
+  Message **outbox ;
+  Search_Stats stats ;
+  struct hda *hda ;
+  int id ;
+} ;
+typedef struct hda_thread Hda_Thread ;
+
+/*
+ * Hda: every thread, the heuristics searched with, the best
+ * solution so far (incumbent) and the work left, ie threads
+ * searching plus messages unread. Status is the first error
+ * of any thread, which ends the search for all of them.
+ */
+struct hda{
+  Hda_Thread *thread ;
+  int threads ;
+  int incumbent ;
+  int goal_thread ;
+  int goal_place ;
+  Heuristic *heuristic ;
+  long work ;
+  int status ;
+  pthread_mutex_t lock ;
+} ;
+typedef struct hda Hda ;
+
+INTERNAL void post_message(Mailbox *mailbox, Message *message) ;
+INTERNAL Message *take_messages(Mailbox *mailbox) ;
+INTERNAL int mailbox_empty(Mailbox *mailbox) ;
+INTERNAL int create_closed(Closed *closed) ;
+INTERNAL unsigned long find_closed(Closed *closed, \
+Packed board) ;
+INTERNAL int closed_moves(Closed *closed, Packed board) ;
+INTERNAL int set_closed(Closed *closed, Packed board, \
+int moves) ;
+INTERNAL int grow_closed(Closed *closed) ;
+INTERNAL void clear_closed(Closed *closed) ;
+INTERNAL void free_closed(Closed *closed) ;
+INTERNAL int create_hda(Hda *hda, int threads) ;
+INTERNAL void hda_fail(Hda *hda, int status) ;
+INTERNAL void drop_messages(Hda_Thread *thread, int threads) ;
+INTERNAL void reset_hda(Hda *hda) ;
+INTERNAL void free_hda(Hda *hda) ;
+
+
+/* Pushes message on the stack, retried until no one else has.*/
+INTERNAL void post_message(Mailbox *mailbox, Message *message)
+{
+  message->next = __atomic_load_n(&mailbox->head, \
+  __ATOMIC_RELAXED) ;
+
+  while(!__atomic_compare_exchange_n(&mailbox->head, \
+  &message->next, message, 1, __ATOMIC_RELEASE, \
+  __ATOMIC_RELAXED)) ;
+
+  return ;
+}
+
+/* Takes every message posted so far, in one exchange. */
+INTERNAL Message *take_messages(Mailbox *mailbox)
+{
+  return __atomic_exchange_n(&mailbox->head, NULL, \
+  __ATOMIC_ACQUIRE) ;
+}
+
+INTERNAL int mailbox_empty(Mailbox *mailbox)
+{
+  return (__atomic_load_n(&mailbox->head, __ATOMIC_ACQUIRE) \
+  == NULL) ? 1 : 0 ;
+}
+
+INTERNAL int create_closed(Closed *closed)
+{
+  closed->slot = (Packed *)calloc(CLOSED_START, \
+  sizeof(Packed)) ;
+
+  closed->moves = (unsigned char *)malloc(CLOSED_START * \
+  sizeof(unsigned char)) ;
+
+  closed->size = CLOSED_START ;
+  closed->count = 0 ;
+
+  return ((closed->slot == NULL) || (closed->moves == NULL)) ? \
+  SOLVER_MEMORY_ERROR : SOLVER_OK ;
+}
+
+/* Slot holding board, or else the empty slot it would use.*/
+INTERNAL unsigned long find_closed(Closed *closed, Packed board)
+{
+  unsigned long i ;
+
+  i = CLOSED_HASH(board, closed->size - 1) ;
+
+  /* Linear probing, the table is never more than half full.*/
+  while((closed->slot[i] != CLOSED_EMPTY) && \
+  (closed->slot[i] != board)){
+    i = (i + 1) & (closed->size - 1) ;
+  }
+
+  return i ;
+}
+
+/* Fewest moves board has been reached in, or CLOSED_NONE. */
+INTERNAL int closed_moves(Closed *closed, Packed board)
+{
+  unsigned long i ;
+
+  i = find_closed(closed, board) ;
+
+  return (closed->slot[i] == CLOSED_EMPTY) ? CLOSED_NONE : \
+  closed->moves[i] ;
+}
+
+INTERNAL int set_closed(Closed *closed, Packed board, int moves)
+{
+  unsigned long i ;
+
+  i = find_closed(closed, board) ;
+
+  closed->moves[i] = (unsigned char)moves ;
+
+  if(closed->slot[i] == CLOSED_EMPTY){
+    closed->slot[i] = board ;
+    closed->count++ ;
+
+    if(closed->count * 2 > closed->size){
+      return grow_closed(closed) ;
+    }
+  }
+
+  return SOLVER_OK ;
+}
+
+/* 
+ * Doubles the table, moving every board to its new slot, or
+ * leaves it as it was if there is no room.
+ */
+INTERNAL int grow_closed(Closed *closed)
+{
+  Closed old ;
+  unsigned long i, j ;
+
+  old = *closed ;
+
+  closed->size = old.size * 2 ;
+
+  closed->slot = (Packed *)calloc(closed->size, \
+  sizeof(Packed)) ;
+
+  closed->moves = (unsigned char *)malloc(closed->size * \
+  sizeof(unsigned char)) ;
+
+  if((closed->slot == NULL) || (closed->moves == NULL)){
+    free(closed->slot) ;
+    free(closed->moves) ;
+    *closed = old ;
+    return SOLVER_MEMORY_ERROR ;
+  }
+
+  for(i = 0 ; i < old.size ; i++){
+    if(old.slot[i] != CLOSED_EMPTY){
+      j = find_closed(closed, old.slot[i]) ;
+
+      closed->slot[j] = old.slot[i] ;
+      closed->moves[j] = old.moves[i] ;
+    }
+  }
+
+  free(old.slot) ;
+  free(old.moves) ;
+
+  return SOLVER_OK ;
+}
+
+/* Empties the table, but keeps its size for the next search.*/
+INTERNAL void clear_closed(Closed *closed)
+{
+  if(closed->count > 0){
+    memset(closed->slot, 0, closed->size * sizeof(Packed)) ;
+  }
+
+  closed->count = 0 ;
+
+  return ;
+}
+
+INTERNAL void free_closed(Closed *closed)
+{
+  free(closed->slot) ;
+
+  free(closed->moves) ;
+
+  return ;
+}
+
+/* 
+ * Makes each thread's arena, open list, table and mailbox.
+ * Whatever was made is freed by free_hda, even on an error.
+ */
+INTERNAL int create_hda(Hda *hda, int threads)
+{
+  Hda_Thread *t ;
+  int i, j, status ;
+
+  pthread_mutex_init(&hda->lock, NULL) ;
+
+  hda->threads = 0 ;
+
+  hda->thread = (Hda_Thread *)malloc(threads * \
+  sizeof(Hda_Thread)) ;
+
+  if(hda->thread == NULL){
+    return SOLVER_MEMORY_ERROR ;
+  }
+
+  for(i = 0 ; i < threads ; i++){
+    t = &hda->thread[hda->threads++] ;
+
+    t->open = (Open_List *)malloc(sizeof(Open_List)) ;
+
+    t->outbox = (Message **)malloc(threads * \
+    sizeof(Message *)) ;
+
+    status = create_arena(&t->arena) ;
+
+    if(t->open != NULL){
+      create_open_list(t->open) ;
+    }
+
+    for(j = 0 ; (t->outbox != NULL) && (j < threads) ; j++){
+      t->outbox[j] = NULL ;
+    }
+
+    if(create_closed(&t->closed) != SOLVER_OK){
+      status = SOLVER_MEMORY_ERROR ;
+    }
+
+    t->stats.expanded = t->stats.generated = 0 ;
+    t->stats.pruned = 0 ;
+    t->mailbox.head = NULL ;
+    t->hda = hda ;
+    t->id = i ;
+
+    if((t->open == NULL) || (t->outbox == NULL) || \
+    (status != SOLVER_OK)){
+      return SOLVER_MEMORY_ERROR ;
+    }
+  }
+
+  return SOLVER_OK ;
+}
+
+/* Keeps the first error of any thread, to end the search. */
+INTERNAL void hda_fail(Hda *hda, int status)
+{
+  int ok ;
+
+  ok = SOLVER_OK ;
+
+  __atomic_compare_exchange_n(&hda->status, &ok, status, 0, \
+  __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST) ;
+
+  return ;
+}
+
+/*
+ * Frees the messages of a thread, and its outboxes. Every
+ * message is read (and outbox sent) before a search ends,
+ * unless it ended on an error.
+ */
+INTERNAL void drop_messages(Hda_Thread *thread, int threads)
+{
+  Message *message, *next ;
+  int i ;
+
+  for(i = 0 ; (thread->outbox != NULL) && (i < threads) ; i++){
+    free(thread->outbox[i]) ;
+    thread->outbox[i] = NULL ;
+  }
+
+  message = take_messages(&thread->mailbox) ;
+
+  while(message != NULL){
+    next = message->next ;
+    free(message) ;
+    message = next ;
+  }
+
+  return ;
+}
+
+/* Empties every thread, ready for the next search. */
+INTERNAL void reset_hda(Hda *hda)
+{
+  int i ;
+
+  for(i = 0 ; i < hda->threads ; i++){
+    drop_messages(&hda->thread[i], hda->threads) ;
+
+    clear_closed(&hda->thread[i].closed) ;
+
+    reset_open_list(hda->thread[i].open) ;
+
+    reset_arena(&hda->thread[i].arena) ;
+  }
+
+  return ;
+}
+
+INTERNAL void free_hda(Hda *hda)
+{
+  int i ;
+
+  for(i = 0 ; i < hda->threads ; i++){
+    drop_messages(&hda->thread[i], hda->threads) ;
+
+    free_closed(&hda->thread[i].closed) ;
+
+    if(hda->thread[i].open != NULL){
+      free_open_list(hda->thread[i].open) ;
+    }
+
+    free(hda->thread[i].open) ;
+
+    free_arena(&hda->thread[i].arena) ;
+
+    free(hda->thread[i].outbox) ;
+  }
+
+  pthread_mutex_destroy(&hda->lock) ;
+
+  free(hda->thread) ;
+
+  return ;
+}
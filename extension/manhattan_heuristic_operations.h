@@ -0,0 +1,419 @@
+/*
+ * Header including the heuristics, other than the Manhattan
+ * distance, that the extension of 8-tile can search with, and
+ * the largest of those chosen (which never over-estimates as
+ * none of them do). Linear conflict adds two moves for each
+ * tile that has to leave its row (or column) to let another
+ * tile of that line past. Inversion distance counts the moves
+ * up and down, and left and right, needed to sort the tiles
+ * in row and column order (see manhattan_make_tables.c).
+ * Pattern databases add up the moves of groups of tiles
+ * (see manhattan_pdb_operations.h), and walking distance the
+ * moves of the counts of tiles in each row and column (see
+ * manhattan_walking_operations.h). Each is carried from
+ * parent to child like the distance, so only the lines,
+ * tiles and table a move changes need be counted.
+ */
+#include <string.h>
+
+#define HEURISTIC_CHECK_ERROR "\nERROR: Estimate of board " \
+"does not match the full recalculation.\n\n"
+
+/*
+ * Names on the command line, separated by commas (see
+ * heuristic_from_names, in manhattan_solver.c).
+ */
+#define MANHATTAN_NAME "md"
+#define CONFLICT_NAME "lc"
+#define INVERSION_NAME "id"
+#define WALKING_NAME "wd"
+#define NAME_SEPARATOR ","
+
+/* Name of length characters at name is n. */
+#define NAME_IS(name, length, n) (((length) == strlen(n)) && \
+(strncmp((name), (n), (length)) == 0))
+
+/* A tile leaving its line, then returning, is two moves. */
+#define CONFLICT_MOVES 2
+
+/* Tiles are read across the rows, or down the columns. */
+#define ROW_ORDER 0
+#define COLUMN_ORDER 1
+
+/* Cell at place i of the order, and place of a cell in it. */
+#define ORDER_CELL(i, order) (((order) == ROW_ORDER) ? (i) : \
+((((i) % YS) * XS) + ((i) / YS)))
+#define ORDER_PLACE(cell, order) (((order) == ROW_ORDER) ? \
+(cell) : ((((cell) % XS) * YS) + ((cell) / XS)))
+
+/* Place a tile (code) has in the order at the goal. */
+#define ORDER_KEY(code, order) (((order) == ROW_ORDER) ? \
+(code) : ((goal_x[code] * YS) + goal_y[code]))
+
+/*
+ * Heuristic: those chosen, and the pattern databases and
+ * walking distance tables, if used.
+ */
+struct heuristic{
+  int chosen ;
+  Pdb_Set *pdb ;
+  Walking *walking ;
+} ;
+typedef struct heuristic Heuristic ;
+
+INTERNAL void score_estimate(Puzzle *board, \
+Heuristic *heuristic) ;
+INTERNAL void update_estimate(Puzzle *current, Puzzle *child, \
+int tile, Heuristic *heuristic) ;
+INTERNAL int estimate(Puzzle *board, Heuristic *heuristic) ;
+INTERNAL int conflict_function(Packed board, int blank) ;
+INTERNAL int row_conflict(Packed board, int blank, int y) ;
+INTERNAL int column_conflict(Packed board, int blank, int x) ;
+INTERNAL int longest_increasing(int *place, int count) ;
+INTERNAL int inversion_function(Packed board, int blank, \
+int order) ;
+INTERNAL int inversion_change(Packed board, int tile, \
+int blank, int order) ;
+INTERNAL int check_estimate(Puzzle *board, \
+Heuristic *heuristic) ;
+
+
+/*
+ * Counts what the heuristics need of board from scratch (its
+ * distance is already set), then its priority. Only done for
+ * the starting board, children are updated.
+ */
+INTERNAL void score_estimate(Puzzle *board, \
+Heuristic *heuristic)
+{
+  board->conflict = board->row_inversions = 0 ;
+  board->column_inversions = board->pattern = 0 ;
+  board->row_walk = board->column_walk = 0 ;
+
+  if(heuristic->chosen & CONFLICT_HEURISTIC){
+    board->conflict = (short)conflict_function(board->board, \
+    board->blank) ;
+  }
+
+  if(heuristic->chosen & INVERSION_HEURISTIC){
+    board->row_inversions = (short)inversion_function( \
+    board->board, board->blank, ROW_ORDER) ;
+
+    board->column_inversions = (short)inversion_function( \
+    board->board, board->blank, COLUMN_ORDER) ;
+  }
+
+  if(heuristic->chosen & PDB_HEURISTIC){
+    board->pattern = (short)pdb_function(heuristic->pdb, \
+    board->board, &board->parts) ;
+  }
+
+  if(heuristic->chosen & WALKING_HEURISTIC){
+    board->row_walk = (short)walking_state( \
+    &heuristic->walking->row, board->board, board->blank) ;
+
+    board->column_walk = (short)walking_state( \
+    &heuristic->walking->column, board->board, board->blank) ;
+  }
+
+  board->manhattan = board->moves + estimate(board, heuristic) ;
+
+  return ;
+}
+
+/*
+ * Child is current with the tile in cell tile slid into the
+ * blank. A move up or down only changes the two rows it is
+ * between (the order down the column stays the same), and
+ * left or right only the two columns.
+ */
+INTERNAL void update_estimate(Puzzle *current, Puzzle *child, \
+int tile, Heuristic *heuristic)
+{
+  int blank, owner, last, moves ;
+
+  blank = current->blank ;
+
+  child->conflict = current->conflict ;
+  child->pattern = current->pattern ;
+  child->parts = current->parts ;
+  child->row_walk = current->row_walk ;
+  child->column_walk = current->column_walk ;
+  child->row_inversions = current->row_inversions ;
+  child->column_inversions = current->column_inversions ;
+
+  if((heuristic->chosen & CONFLICT_HEURISTIC) && \
+  (tile / XS == blank / XS)){
+    child->conflict += column_conflict(child->board, tile, \
+    tile % XS) + column_conflict(child->board, tile, \
+    blank % XS) - column_conflict(current->board, blank, \
+    tile % XS) - column_conflict(current->board, blank, \
+    blank % XS) ;
+  }
+
+  else if(heuristic->chosen & CONFLICT_HEURISTIC){
+    child->conflict += row_conflict(child->board, tile, \
+    tile / XS) + row_conflict(child->board, tile, \
+    blank / XS) - row_conflict(current->board, blank, \
+    tile / XS) - row_conflict(current->board, blank, \
+    blank / XS) ;
+  }
+
+  /* The order the move is across gives no tiles to pass. */
+  if(heuristic->chosen & INVERSION_HEURISTIC){
+    child->row_inversions += inversion_change(current->board, \
+    tile, blank, ROW_ORDER) ;
+
+    child->column_inversions += inversion_change( \
+    current->board, tile, blank, COLUMN_ORDER) ;
+  }
+
+  /* The blank takes a tile of its goal row (or column). */
+  if((heuristic->chosen & WALKING_HEURISTIC) && \
+  (tile / XS != blank / XS)){
+    child->row_walk = WALKING_LINK(&heuristic->walking->row, \
+    current->row_walk, (tile < blank) ? WALKING_BACK : \
+    WALKING_ON, goal_y[CELL(current->board, tile)]) ;
+  }
+
+  else if(heuristic->chosen & WALKING_HEURISTIC){
+    child->column_walk = WALKING_LINK( \
+    &heuristic->walking->column, current->column_walk, \
+    (tile < blank) ? WALKING_BACK : WALKING_ON, \
+    goal_x[CELL(current->board, tile)]) ;
+  }
+
+  /* Only the table holding the tile that moved changes. */
+  if(heuristic->chosen & PDB_HEURISTIC){
+    owner = heuristic->pdb->owner[CELL(current->board, tile)] ;
+
+    if(owner != PDB_NONE){
+      last = PART(current->parts, owner) ;
+
+      moves = pdb_distance(&heuristic->pdb->pdb[owner], \
+      child->board, last) ;
+
+      child->parts = SET_PART(child->parts, owner, moves) ;
+      child->pattern += moves - last ;
+    }
+  }
+
+  return ;
+}
+
+/* Largest of the heuristics chosen for board (without moves).*/
+INTERNAL int estimate(Puzzle *board, Heuristic *heuristic)
+{
+  int h, moves ;
+
+  h = (heuristic->chosen & MANHATTAN_HEURISTIC) ? \
+  board->distance : 0 ;
+
+  if(heuristic->chosen & CONFLICT_HEURISTIC){
+    moves = board->distance + (CONFLICT_MOVES * \
+    board->conflict) ;
+
+    h = (moves > h) ? moves : h ;
+  }
+
+  if(heuristic->chosen & INVERSION_HEURISTIC){
+    moves = row_inversion_moves[board->row_inversions] + \
+    column_inversion_moves[board->column_inversions] ;
+
+    h = (moves > h) ? moves : h ;
+  }
+
+  if(heuristic->chosen & PDB_HEURISTIC){
+    h = (board->pattern > h) ? board->pattern : h ;
+  }
+
+  if(heuristic->chosen & WALKING_HEURISTIC){
+    moves = heuristic->walking->row.moves[board->row_walk] + \
+    heuristic->walking->column.moves[board->column_walk] ;
+
+    h = (moves > h) ? moves : h ;
+  }
+
+  return h ;
+}
+
+/* Tiles that must leave their line, over every row and column.*/
+INTERNAL int conflict_function(Packed board, int blank)
+{
+  int i, conflict ;
+
+  conflict = 0 ;
+
+  for(i = 0 ; i < YS ; i++){
+    conflict += row_conflict(board, blank, i) ;
+  }
+
+  for(i = 0 ; i < XS ; i++){
+    conflict += column_conflict(board, blank, i) ;
+  }
+
+  return conflict ;
+}
+
+/*
+ * Tiles in row y that belong in it, less the most of them
+ * already in order, ie the fewest that must leave the row.
+ */
+INTERNAL int row_conflict(Packed board, int blank, int y)
+{
+  int x, cell, code, count, place[XS] ;
+
+  count = 0 ;
+
+  for(x = 0 ; x < XS ; x++){
+    cell = (y * XS) + x ;
+    code = CELL(board, cell) ;
+
+    if((cell != blank) && (goal_y[code] == y)){
+      place[count++] = goal_x[code] ;
+    }
+  }
+
+  return count - longest_increasing(place, count) ;
+}
+
+/* As row_conflict, for the tiles down column x. */
+INTERNAL int column_conflict(Packed board, int blank, int x)
+{
+  int y, cell, code, count, place[YS] ;
+
+  count = 0 ;
+
+  for(y = 0 ; y < YS ; y++){
+    cell = (y * XS) + x ;
+    code = CELL(board, cell) ;
+
+    if((cell != blank) && (goal_x[code] == x)){
+      place[count++] = goal_y[code] ;
+    }
+  }
+
+  return count - longest_increasing(place, count) ;
+}
+
+/* Longest run (not always next to each other) in order. */
+INTERNAL int longest_increasing(int *place, int count)
+{
+  int i, j, longest, run[MAX_CELLS] ;
+
+  longest = 0 ;
+
+  for(i = 0 ; i < count ; i++){
+    run[i] = 1 ;
+
+    for(j = 0 ; j < i ; j++){
+      if((place[j] < place[i]) && (run[j] + 1 > run[i])){
+        run[i] = run[j] + 1 ;
+      }
+    }
+
+    longest = (run[i] > longest) ? run[i] : longest ;
+  }
+
+  return longest ;
+}
+
+/* Pairs of tiles the wrong way round, read in the order. */
+INTERNAL int inversion_function(Packed board, int blank, \
+int order)
+{
+  int i, j, first, second, inversions ;
+
+  inversions = 0 ;
+
+  for(i = 0 ; i < NUM_TILES ; i++){
+    first = ORDER_CELL(i, order) ;
+
+    for(j = i + 1 ; (first != blank) && (j < NUM_TILES) ; j++){
+      second = ORDER_CELL(j, order) ;
+
+      if((second != blank) && \
+      (ORDER_KEY(CELL(board, first), order) > \
+      ORDER_KEY(CELL(board, second), order))){
+        inversions++ ;
+      }
+    }
+  }
+
+  return inversions ;
+}
+
+/*
+ * Change in the inversions (in the order) when the tile in
+ * cell tile slides into the blank, ie jumps the tiles between.
+ */
+INTERNAL int inversion_change(Packed board, int tile, \
+int blank, int order)
+{
+  int i, from, to, key, other, change ;
+
+  from = ORDER_PLACE(tile, order) ;
+  to = ORDER_PLACE(blank, order) ;
+  key = ORDER_KEY(CELL(board, tile), order) ;
+  change = 0 ;
+
+  for(i = (from < to ? from : to) + 1 ; \
+  i < (from < to ? to : from) ; i++){
+    other = ORDER_KEY(CELL(board, ORDER_CELL(i, order)), order) ;
+
+    /* Each pair passed swaps, ie is now (or no longer) wrong.*/
+    if((to < from) == (key > other)){
+      change++ ;
+    }
+
+    else{
+      change-- ;
+    }
+  }
+
+  return change ;
+}
+
+/*
+ * Debug only - catches any drift of what the heuristics carry
+ * from parent to child, against a full count.
+ */
+INTERNAL int check_estimate(Puzzle *board, Heuristic *heuristic)
+{
+  Packed parts ;
+
+  if((heuristic->chosen & CONFLICT_HEURISTIC) && \
+  (board->conflict != conflict_function(board->board, \
+  board->blank))){
+    return SOLVER_ESTIMATE_ERROR ;
+  }
+
+  if((heuristic->chosen & INVERSION_HEURISTIC) && \
+  ((board->row_inversions != inversion_function(board->board, \
+  board->blank, ROW_ORDER)) || (board->column_inversions != \
+  inversion_function(board->board, board->blank, \
+  COLUMN_ORDER)))){
+    return SOLVER_ESTIMATE_ERROR ;
+  }
+
+  if((heuristic->chosen & PDB_HEURISTIC) && ((board->pattern \
+  != pdb_function(heuristic->pdb, board->board, &parts)) || \
+  (board->parts != parts))){
+    return SOLVER_ESTIMATE_ERROR ;
+  }
+
+  if((heuristic->chosen & WALKING_HEURISTIC) && \
+  ((board->row_walk != walking_state(&heuristic->walking->row, \
+  board->board, board->blank)) || (board->column_walk != \
+  walking_state(&heuristic->walking->column, board->board, \
+  board->blank)))){
+    return SOLVER_ESTIMATE_ERROR ;
+  }
+
+  if(board->manhattan != board->moves + estimate(board, \
+  heuristic)){
+    return SOLVER_ESTIMATE_ERROR ;
+  }
+
+  return SOLVER_OK ;
+}
@@ -0,0 +1,59 @@
+/*
+ * Header including the names used inside the extension of
+ * 8-tile, for its modules, tools and command line, but not
+ * for a program using the solver library (which only needs
+ * manhattan_solver.h). The board size, tiles, searches and
+ * heuristics are the library's, under their short names.
+ */
+#ifndef MANHATTAN_INTERNAL_H
+#define MANHATTAN_INTERNAL_H
+
+#include "manhattan_solver.h"
+
+/* Height, width and total number of tiles. */
+#ifndef YS
+#define YS SOLVER_YS
+#endif
+#ifndef XS
+#define XS SOLVER_XS
+#endif
+#define NUM_TILES SOLVER_TILES
+
+/* Total number of tiles not including the blank tile. */
+#define NUM_WO_BLANK (NUM_TILES - 1)
+
+/* Blank tile defined as space character. */
+#define BLANK SOLVER_BLANK
+
+/* Tiles after '9' are lettered, ie tile 10 is 'A'. */
+#define TILE_CHAR(n) (((n) <= 9) ? ('0' + (n)) : \
+('A' + (n) - 10))
+#define CHAR_TILE(c) (((c) >= 'A') ? ((c) - 'A' + 10) : \
+((c) - '0'))
+#define TILE_CHAR_CHECK(c) ((((c) >= '1') && ((c) <= '9')) \
+|| (((c) >= 'A') && ((c) <= 'Z')))
+
+/* Search used to solve the board. */
+#define A_STAR SOLVER_A_STAR
+#define IDA_STAR SOLVER_IDA_STAR
+#define ORACLE SOLVER_ORACLE
+#define HDA_STAR SOLVER_HDA_STAR
+
+/* Heuristics that can be chosen, as bits, so combined. */
+#define MANHATTAN_HEURISTIC SOLVER_MANHATTAN
+#define CONFLICT_HEURISTIC SOLVER_CONFLICT
+#define INVERSION_HEURISTIC SOLVER_INVERSION
+#define PDB_HEURISTIC SOLVER_PDB
+#define WALKING_HEURISTIC SOLVER_WALKING
+
+/* Search_Stats: counts kept by the search. */
+typedef Solver_Stats Search_Stats ;
+
+/*
+ * Functions of the _operations.h headers are compiled into
+ * each program including them, and kept to it, so that the
+ * library only gives its API. Not every tool uses them all.
+ */
+#define INTERNAL static __attribute__((unused))
+
+#endif
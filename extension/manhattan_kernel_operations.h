@@ -0,0 +1,192 @@
+/*
+ * Header including the kernel that works out the Manhattan
+ * distance of many packed boards at once, for the extension
+ * of 8-tile. With AVX2, eight boards are scored per pass, as
+ * four pairs: each board is spread out to a byte per cell (in
+ * its own 128-bit lane), the row and column each code belongs
+ * in are looked up for every cell at once with a byte
+ * shuffle, and the distances summed. The four pairs do not
+ * depend on each other, so their shuffles overlap, and their
+ * sums are added across into the eight distances at once.
+ * The CPU is checked (CPUID) each call, so the same program
+ * runs the scalar loop on any other CPU.
+ */
+#if defined(__x86_64__)
+#define KERNEL_AVX2
+#include <immintrin.h>
+#endif
+
+/* Boards scored in one pass, and in each register of it. */
+#define KERNEL_BOARDS 8
+#define KERNEL_LANES 2
+
+/* Bytes of each shuffle table, ie one per cell per lane. */
+#define KERNEL_BYTES 32
+#define LANE_CELLS 16
+
+/*
+ * Code i belongs in cell i (see manhattan_tables.h), so the
+ * row and column of a code and of a cell are the same table,
+ * known once the board size is. Cells past the last cell of
+ * the board hold code 0 (cell 0 at the goal), so their row
+ * and column are 0 and they add no distance.
+ */
+#define KERNEL_ROW(i) (((i) < NUM_TILES) ? ((i) / XS) : 0)
+#define KERNEL_COLUMN(i) (((i) < NUM_TILES) ? ((i) % XS) : 0)
+#define KERNEL_CELL(i) (i)
+
+/*
+ * Lane 0 spreads the bytes of the first board, and lane 1
+ * the second's, each byte (two cells) twice.
+ */
+#define KERNEL_SPREAD(i) ((i) / 2)
+#define KERNEL_SPREAD_ON(i) ((int)sizeof(Packed) + ((i) / 2))
+
+/* Second of each two bytes takes the high nibble. */
+#define KERNEL_ODD(i) (((i) % 2) ? -1 : 0)
+
+#define KERNEL_LANE(f) {f(0), f(1), f(2), f(3), f(4), f(5), \
+f(6), f(7), f(8), f(9), f(10), f(11), f(12), f(13), f(14), \
+f(15)}
+
+/* Kernel_Table: one table, as the two lanes of a register. */
+struct kernel_table{
+  char lane[KERNEL_LANES][LANE_CELLS] ;
+} ;
+typedef struct kernel_table Kernel_Table ;
+
+static const Kernel_Table kernel_row = \
+{{KERNEL_LANE(KERNEL_ROW), KERNEL_LANE(KERNEL_ROW)}} ;
+static const Kernel_Table kernel_column = \
+{{KERNEL_LANE(KERNEL_COLUMN), KERNEL_LANE(KERNEL_COLUMN)}} ;
+static const Kernel_Table kernel_cell = \
+{{KERNEL_LANE(KERNEL_CELL), KERNEL_LANE(KERNEL_CELL)}} ;
+static const Kernel_Table kernel_spread = \
+{{KERNEL_LANE(KERNEL_SPREAD), KERNEL_LANE(KERNEL_SPREAD_ON)}} ;
+static const Kernel_Table kernel_odd = \
+{{KERNEL_LANE(KERNEL_ODD), KERNEL_LANE(KERNEL_ODD)}} ;
+
+INTERNAL void score_boards(Packed *board, int *blank, \
+int *distance, int count) ;
+INTERNAL void score_boards_scalar(Packed *board, int *blank, \
+int *distance, int count) ;
+#ifdef KERNEL_AVX2
+INTERNAL void score_boards_avx2(Packed *board, int *blank, \
+int *distance, int count) __attribute__((target("avx2"))) ;
+INTERNAL __m256i score_pair(Packed *board, int *blank) \
+__attribute__((target("avx2"))) ;
+#endif
+
+
+/* Distance of each board (without moves), best kernel. */
+INTERNAL void score_boards(Packed *board, int *blank, \
+int *distance, int count)
+{
+#ifdef KERNEL_AVX2
+  if(__builtin_cpu_supports("avx2")){
+    score_boards_avx2(board, blank, distance, count) ;
+
+    return ;
+  }
+#endif
+
+  score_boards_scalar(board, blank, distance, count) ;
+
+  return ;
+}
+
+/* One board at a time, see manhattan_function. */
+INTERNAL void score_boards_scalar(Packed *board, int *blank, \
+int *distance, int count)
+{
+  int i ;
+
+  for(i = 0 ; i < count ; i++){
+    *(distance + i) = manhattan_function(*(board + i), \
+    *(blank + i), 0) ;
+  }
+
+  return ;
+}
+
+#ifdef KERNEL_AVX2
+/*
+ * Eight boards per pass, then two, and any left over are
+ * scored by the scalar loop.
+ */
+INTERNAL void score_boards_avx2(Packed *board, int *blank, \
+int *distance, int count)
+{
+  __m256i order, sums ;
+  int i ;
+
+  /* Adding across gives boards 0, 2, 4, 6, then 1, 3, 5, 7. */
+  order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7) ;
+
+  for(i = 0 ; i + KERNEL_BOARDS <= count ; i += KERNEL_BOARDS){
+    sums = _mm256_hadd_epi32(_mm256_hadd_epi32( \
+    score_pair(board + i, blank + i), score_pair(board + i + 2, \
+    blank + i + 2)), _mm256_hadd_epi32(score_pair(board + i + 4, \
+    blank + i + 4), score_pair(board + i + 6, blank + i + 6))) ;
+
+    _mm256_storeu_si256((__m256i *)(distance + i), \
+    _mm256_permutevar8x32_epi32(sums, order)) ;
+  }
+
+  for( ; i + KERNEL_LANES <= count ; i += KERNEL_LANES){
+    sums = score_pair(board + i, blank + i) ;
+
+    *(distance + i) = (int)(_mm256_extract_epi64(sums, 0) + \
+    _mm256_extract_epi64(sums, 1)) ;
+
+    *(distance + i + 1) = (int)(_mm256_extract_epi64(sums, 2) \
+    + _mm256_extract_epi64(sums, 3)) ;
+  }
+
+  score_boards_scalar(board + i, blank + i, distance + i, \
+  count - i) ;
+
+  return ;
+}
+
+/*
+ * Distance of two boards, as the sums of cells 0 to 7 and of
+ * cells 8 to 15 of each (a 64-bit sum apiece, in order).
+ */
+INTERNAL __m256i score_pair(Packed *board, int *blank)
+{
+  __m256i rows, columns, bytes, codes, blanks, moves ;
+
+  rows = _mm256_loadu_si256((const __m256i *)&kernel_row) ;
+  columns = _mm256_loadu_si256( \
+  (const __m256i *)&kernel_column) ;
+
+  /* Both boards in each lane, then spread to a byte a cell. */
+  bytes = _mm256_shuffle_epi8(_mm256_broadcastsi128_si256( \
+  _mm_loadu_si128((const __m128i *)board)), \
+  _mm256_loadu_si256((const __m256i *)&kernel_spread)) ;
+
+  codes = _mm256_and_si256(_mm256_blendv_epi8(bytes, \
+  _mm256_srli_epi16(bytes, CELL_BITS), \
+  _mm256_loadu_si256((const __m256i *)&kernel_odd)), \
+  _mm256_set1_epi8((char)CELL_MASK)) ;
+
+  /* |goal row - row| + |goal column - column| per cell. */
+  moves = _mm256_add_epi8(_mm256_abs_epi8(_mm256_sub_epi8( \
+  _mm256_shuffle_epi8(rows, codes), rows)), \
+  _mm256_abs_epi8(_mm256_sub_epi8(_mm256_shuffle_epi8(columns, \
+  codes), columns))) ;
+
+  /* Blank's cell is not counted. */
+  blanks = _mm256_inserti128_si256(_mm256_castsi128_si256( \
+  _mm_set1_epi8((char)*blank)), _mm_set1_epi8( \
+  (char)*(blank + 1)), 1) ;
+
+  moves = _mm256_andnot_si256(_mm256_cmpeq_epi8( \
+  _mm256_loadu_si256((const __m256i *)&kernel_cell), blanks), \
+  moves) ;
+
+  /* Sum of each 8 bytes, so two sums per board. */
+  return _mm256_sad_epu8(moves, _mm256_setzero_si256()) ;
+}
+#endif
@@ -0,0 +1,144 @@
+/*
+ * Generates the distance oracle for the extension of 8-tile
+ * (see manhattan_oracle_operations.h). Starting from the
+ * solution, a backwards BFS labels every solvable board with
+ * its number of moves from the solution, which is written,
+ * 4 bits per board, to the file given (or ORACLE_FILE).
+ */
+#define _POSIX_C_SOURCE 200112L
+#include <stdio.h>
+#include <stdlib.h>
+#include "manhattan_file_operations.h"
+#include "manhattan_board_operations.h"
+#include "manhattan_tables.h"
+#include "manhattan_oracle_operations.h"
+
+#define MAKE_ORACLE_MEMORY_ERROR "\nERROR: Unable to allocate " \
+"space for the distance oracle.\n\n"
+#define MAKE_ORACLE_FILE_ERROR "\nERROR: Cannot write the " \
+"distance oracle: %s\n\n"
+#define MAKE_ORACLE_COUNT_ERROR "\nERROR: Only %ld of the " \
+"%d solvable boards were reached.\n\n"
+
+/* Every board starts unlabelled. */
+#define UNLABELLED 0xFF
+
+/* Solution has its blank in the last cell. */
+#define SOLUTION_BLANK NUM_WO_BLANK
+
+/* Open_Board: a board waiting in the BFS queue. */
+struct open_board{
+  Packed board ;
+  int blank ;
+} ;
+typedef struct open_board Open_Board ;
+
+void label_boards(unsigned char *distance, Open_Board *queue) ;
+void write_oracle(unsigned char *distance, char *file) ;
+
+
+int main(int argc, char *argv[])
+{
+  unsigned char *distance ;
+  Open_Board *queue ;
+
+  distance = (unsigned char *)malloc(ORACLE_STATES * \
+  sizeof(unsigned char)) ;
+
+  queue = (Open_Board *)malloc(ORACLE_STATES * \
+  sizeof(Open_Board)) ;
+
+  if((distance == NULL) || (queue == NULL)){
+    fprintf(stderr, MAKE_ORACLE_MEMORY_ERROR) ;
+    exit(EXIT_FAILURE) ;
+  }
+
+  label_boards(distance, queue) ;
+
+  write_oracle(distance, (argc == 2) ? argv[1] : ORACLE_FILE) ;
+
+  free(queue) ;
+
+  free(distance) ;
+
+  return 0 ;
+}
+
+/* BFS from the solution - each board is labelled once. */
+void label_boards(unsigned char *distance, Open_Board *queue)
+{
+  Open_Board current ;
+  Packed child ;
+  long head, tail, i ;
+  int j, tile ;
+
+  for(i = 0 ; i < ORACLE_STATES ; i++){
+    distance[i] = UNLABELLED ;
+  }
+
+  head = tail = 0 ;
+
+  queue[tail].board = PACKED_SOLUTION ;
+  queue[tail++].blank = SOLUTION_BLANK ;
+  distance[oracle_index(PACKED_SOLUTION, SOLUTION_BLANK)] = 0 ;
+
+  while(head < tail){
+    current = queue[head++] ;
+
+    for(j = 0 ; j < neighbour_count[current.blank] ; j++){
+      tile = neighbour[current.blank][j] ;
+
+      child = slide_tile(current.board, tile, current.blank) ;
+
+      i = oracle_index(child, tile) ;
+
+      /* Moves are reversible, so BFS order is distance order.*/
+      if(distance[i] == UNLABELLED){
+        distance[i] = distance[oracle_index(current.board, \
+        current.blank)] + 1 ;
+
+        queue[tail].board = child ;
+        queue[tail++].blank = tile ;
+      }
+    }
+  }
+
+  /* Every solvable board must be reached from the solution. */
+  if(tail != ORACLE_STATES){
+    fprintf(stderr, MAKE_ORACLE_COUNT_ERROR, tail, \
+    ORACLE_STATES) ;
+    exit(EXIT_FAILURE) ;
+  }
+
+  return ;
+}
+
+/* Packs the distances (mod 16) two to a byte, then writes. */
+void write_oracle(unsigned char *distance, char *file)
+{
+  FILE *out ;
+  unsigned char byte ;
+  long i ;
+
+  if((out = fopen(file, "wb")) == NULL){
+    fprintf(stderr, MAKE_ORACLE_FILE_ERROR, file) ;
+    exit(EXIT_FAILURE) ;
+  }
+
+  for(i = 0 ; i < ORACLE_STATES ; i += 2){
+    byte = (distance[i] & ORACLE_MASK) | \
+    ((distance[i + 1] & ORACLE_MASK) << ORACLE_BITS) ;
+
+    if(fputc(byte, out) == EOF){
+      fprintf(stderr, MAKE_ORACLE_FILE_ERROR, file) ;
+      exit(EXIT_FAILURE) ;
+    }
+  }
+
+  if(fclose(out) != 0){
+    fprintf(stderr, MAKE_ORACLE_FILE_ERROR, file) ;
+    exit(EXIT_FAILURE) ;
+  }
+
+  return ;
+}
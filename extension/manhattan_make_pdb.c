@@ -0,0 +1,400 @@
+/*
+ * Generates a pattern database for the extension of 8-tile
+ * (see manhattan_pdb_operations.h). Starting from the tiles
+ * of the pattern in their goal cells, a backwards BFS labels
+ * every arrangement of those tiles with the fewest moves of
+ * them alone back to the goal. The pattern is given as the
+ * tiles of the usual goal (eg 1234567), and the table is
+ * written, a byte per entry after the header, to the file.
+ *
+ * Each layer (the entries labelled at one depth) is a bitmap
+ * over the table, shared out between threads in order, so
+ * the entries a thread looks up are close together. An entry
+ * is labelled with an atomic compare and swap of its byte,
+ * and only the thread that labels it marks it (with an atomic
+ * or) in the bitmap of the next layer. Once every thread is
+ * done (at a barrier), the next layer is expanded. The table
+ * is written (see save_pdb) to a temporary file, which is
+ * then renamed, so a solver never maps half of one.
+ */
+#define _POSIX_C_SOURCE 200112L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "manhattan_file_operations.h"
+#include "manhattan_board_operations.h"
+#include "manhattan_tables.h"
+#include "manhattan_pdb_operations.h"
+
+#define MAKE_PDB_ARGS_ERROR "\nERROR: Unexpected input.\n" \
+"Please try something like: %s 1234567 pattern.bin\n" \
+"Or, with N threads: %s -t N 1234567 pattern.bin\n" \
+"(each tile once, and never the blank)\n\n"
+#define MAKE_PDB_MEMORY_ERROR "\nERROR: Unable to allocate " \
+"space for the pattern database.\n\n"
+#define MAKE_PDB_THREAD_ERROR "\nERROR: Unable to start a " \
+"thread to make the pattern database.\n\n"
+
+#define THREADS_FLAG "-t"
+
+/* Bytes of the layer's bitmap a thread takes at a time. */
+#define PDB_SHARE 4096
+
+/* Marks entry i of a layer, from any thread. */
+#define MARK_ENTRY(l, i) (__atomic_fetch_or(&(l)[(i) >> 3], \
+(unsigned char)(1 << ((i) & 7)), __ATOMIC_RELAXED))
+
+/*
+ * Builder: what the threads share. Layer is the bitmap of
+ * the entries being expanded, next that of the entries they
+ * label, and share the first byte of layer not yet taken by
+ * a thread. Added is the entries each thread has labelled.
+ */
+struct builder{
+  Pdb *pdb ;
+  unsigned char *table ;
+  unsigned char *layer ;
+  unsigned char *next ;
+  long bytes ;
+  long share ;
+  long *added ;
+  pthread_barrier_t barrier ;
+  int threads ;
+  int depth ;
+  long reached ;
+  int stop ;
+} ;
+typedef struct builder Builder ;
+
+/* Builder_Worker: what each thread is started with. */
+struct builder_worker{
+  Builder *builder ;
+  int id ;
+} ;
+typedef struct builder_worker Builder_Worker ;
+
+void pattern_from_tiles(char *tiles, Pdb *pdb, char *name) ;
+void label_pdb(Pdb *pdb, unsigned char *table, int threads) ;
+void *builder_worker(void *arg) ;
+void expand_share(Builder *builder, int id) ;
+long expand_entry(Builder *builder, long index) ;
+void join_layer(Builder *builder) ;
+
+
+int main(int argc, char *argv[])
+{
+  Pdb pdb ;
+  unsigned char *table ;
+  int first, threads, status ;
+
+  threads = (int)sysconf(_SC_NPROCESSORS_ONLN) ;
+  first = 1 ;
+
+  if((argc == 5) && (strcmp(argv[1], THREADS_FLAG) == 0) && \
+  (atoi(argv[2]) > 0)){
+    threads = atoi(argv[2]) ;
+    first = 3 ;
+  }
+
+  if((argc != first + 2) || (threads < 1)){
+    fprintf(stderr, MAKE_PDB_ARGS_ERROR, argv[0], argv[0]) ;
+    exit(EXIT_FAILURE) ;
+  }
+
+  pattern_from_tiles(argv[first], &pdb, argv[0]) ;
+
+  table = (unsigned char *)malloc(pdb.entries * \
+  sizeof(unsigned char)) ;
+
+  if(table == NULL){
+    fprintf(stderr, MAKE_PDB_MEMORY_ERROR) ;
+    exit(EXIT_FAILURE) ;
+  }
+
+  label_pdb(&pdb, table, threads) ;
+
+  status = save_pdb(&pdb, table, argv[first + 1]) ;
+
+  free(table) ;
+
+  if(status != SOLVER_OK){
+    fprintf(stderr, pdb_message(status), argv[first + 1]) ;
+    exit(EXIT_FAILURE) ;
+  }
+
+  return 0 ;
+}
+
+/*
+ * Codes of the tiles (chars of the usual goal) of pattern,
+ * kept exactly, a byte per entry.
+ */
+void pattern_from_tiles(char *tiles, Pdb *pdb, char *name)
+{
+  Goal goal ;
+  int i, number, seen[MAX_CELLS] = {0} ;
+
+  usual_goal(&goal) ;
+
+  for(i = 0 ; tiles[i] != '\0' ; i++){
+    number = CHAR_TILE(tiles[i]) ;
+
+    if((i == NUM_WO_BLANK) || !TILE_CHAR_CHECK(tiles[i]) || \
+    (number < 1) || (number > NUM_WO_BLANK) || seen[number]){
+      fprintf(stderr, MAKE_PDB_ARGS_ERROR, name, name) ;
+      exit(EXIT_FAILURE) ;
+    }
+
+    seen[number] = 1 ;
+    pdb->code[i] = goal.code[number] ;
+  }
+
+  if(i == 0){
+    fprintf(stderr, MAKE_PDB_ARGS_ERROR, name, name) ;
+    exit(EXIT_FAILURE) ;
+  }
+
+  pdb->tiles = i ;
+  pdb->format = PDB_BYTES ;
+  pdb->group = 1 ;
+  pdb->exact = 1 ;
+
+  pdb_places(pdb) ;
+
+  return ;
+}
+
+/*
+ * BFS from the goal, a layer at a time, on threads threads
+ * (the first is this one), until a layer adds none.
+ */
+void label_pdb(Pdb *pdb, unsigned char *table, int threads)
+{
+  Builder builder ;
+  Builder_Worker *worker ;
+  pthread_t *thread ;
+  int i, cell[MAX_CELLS] ;
+  long index ;
+
+  for(index = 0 ; index < pdb->entries ; index++){
+    table[index] = PDB_UNREACHED ;
+  }
+
+  /* Code i belongs in cell i. */
+  for(i = 0 ; i < pdb->tiles ; i++){
+    cell[pdb->code[i]] = pdb->code[i] ;
+  }
+
+  builder.bytes = (pdb->entries + 7) / 8 ;
+  builder.layer = (unsigned char *)calloc(builder.bytes, 1) ;
+  builder.next = (unsigned char *)calloc(builder.bytes, 1) ;
+  builder.added = (long *)calloc(threads, sizeof(long)) ;
+  thread = (pthread_t *)malloc(threads * sizeof(pthread_t)) ;
+
+  worker = (Builder_Worker *)malloc(threads * \
+  sizeof(Builder_Worker)) ;
+
+  if((builder.layer == NULL) || (builder.next == NULL) || \
+  (builder.added == NULL) || (thread == NULL) || \
+  (worker == NULL)){
+    fprintf(stderr, MAKE_PDB_MEMORY_ERROR) ;
+    exit(EXIT_FAILURE) ;
+  }
+
+  builder.pdb = pdb ;
+  builder.table = table ;
+  builder.threads = threads ;
+  builder.depth = 0 ;
+  builder.share = 0 ;
+  builder.reached = 1 ;
+  builder.stop = 0 ;
+
+  /* Goal is the only entry in the first layer. */
+  index = pdb_index(pdb, cell) ;
+  table[index] = 0 ;
+  MARK_ENTRY(builder.layer, index) ;
+
+  printf("Depth %2d: %11ld entries\n", 0, 1L) ;
+
+  pthread_barrier_init(&builder.barrier, NULL, threads) ;
+
+  for(i = 0 ; i < threads ; i++){
+    worker[i].builder = &builder ;
+    worker[i].id = i ;
+  }
+
+  for(i = 1 ; i < threads ; i++){
+    if(pthread_create(&thread[i], NULL, builder_worker, \
+    &worker[i]) != 0){
+      fprintf(stderr, MAKE_PDB_THREAD_ERROR) ;
+      exit(EXIT_FAILURE) ;
+    }
+  }
+
+  builder_worker(&worker[0]) ;
+
+  for(i = 1 ; i < threads ; i++){
+    pthread_join(thread[i], NULL) ;
+  }
+
+  pthread_barrier_destroy(&builder.barrier) ;
+
+  free(builder.layer) ;
+  free(builder.next) ;
+  free(builder.added) ;
+  free(worker) ;
+  free(thread) ;
+
+  return ;
+}
+
+/* One thread, until a layer adds no entries. */
+void *builder_worker(void *arg)
+{
+  Builder_Worker *worker ;
+  Builder *builder ;
+
+  worker = (Builder_Worker *)arg ;
+  builder = worker->builder ;
+
+  while(1){
+    expand_share(builder, worker->id) ;
+
+    pthread_barrier_wait(&builder->barrier) ;
+
+    /* One thread swaps the bitmaps and reports the layer. */
+    if(worker->id == 0){
+      join_layer(builder) ;
+    }
+
+    pthread_barrier_wait(&builder->barrier) ;
+
+    if(builder->stop){
+      return NULL ;
+    }
+  }
+}
+
+/* Expands entries of the layer, PDB_SHARE bytes at a time.*/
+void expand_share(Builder *builder, int id)
+{
+  long i, first, last ;
+  int j ;
+
+  while((first = __atomic_fetch_add(&builder->share, PDB_SHARE, \
+  __ATOMIC_RELAXED)) < builder->bytes){
+    last = (first + PDB_SHARE < builder->bytes) ? \
+    (first + PDB_SHARE) : builder->bytes ;
+
+    for(i = first ; i < last ; i++){
+      for(j = 0 ; (builder->layer[i] != 0) && (j < 8) ; j++){
+        if(builder->layer[i] & (1 << j)){
+          builder->added[id] += expand_entry(builder, \
+          (i << 3) + j) ;
+        }
+      }
+    }
+  }
+
+  return ;
+}
+
+/*
+ * Labels each arrangement one move of a pattern tile (into a
+ * cell no other pattern tile is in) from entry index, that
+ * is not yet labelled, and marks it in the next layer.
+ * Returns how many were labelled.
+ */
+long expand_entry(Builder *builder, long index)
+{
+  Pdb *pdb ;
+  unsigned char unreached, depth ;
+  unsigned int used ;
+  long next, added ;
+  int i, j, code, from, to, cell[MAX_CELLS] ;
+
+  pdb = builder->pdb ;
+  depth = (unsigned char)(builder->depth + 1) ;
+
+  pdb_cells(pdb, index, cell) ;
+
+  used = 0 ;
+  added = 0 ;
+
+  for(i = 0 ; i < pdb->tiles ; i++){
+    used |= 1U << cell[pdb->code[i]] ;
+  }
+
+  for(i = 0 ; i < pdb->tiles ; i++){
+    code = pdb->code[i] ;
+    from = cell[code] ;
+
+    for(j = 0 ; j < neighbour_count[from] ; j++){
+      to = neighbour[from][j] ;
+
+      if(used & (1U << to)){
+        continue ;
+      }
+
+      cell[code] = to ;
+      next = pdb_index(pdb, cell) ;
+      unreached = PDB_UNREACHED ;
+
+      /* Read first, as most are labelled by then. */
+      if((__atomic_load_n(&builder->table[next], \
+      __ATOMIC_RELAXED) == PDB_UNREACHED) && \
+      __atomic_compare_exchange_n(&builder->table[next], \
+      &unreached, depth, 0, __ATOMIC_RELAXED, \
+      __ATOMIC_RELAXED)){
+        MARK_ENTRY(builder->next, next) ;
+        added++ ;
+      }
+    }
+
+    cell[code] = from ;
+  }
+
+  return added ;
+}
+
+/*
+ * Next layer is expanded after this one (whose bitmap is
+ * cleared to hold the layer after), reports its size, and
+ * decides if the search is over.
+ */
+void join_layer(Builder *builder)
+{
+  unsigned char *layer ;
+  long total ;
+  int i ;
+
+  total = 0 ;
+
+  for(i = 0 ; i < builder->threads ; i++){
+    total += builder->added[i] ;
+    builder->added[i] = 0 ;
+  }
+
+  layer = builder->layer ;
+  builder->layer = builder->next ;
+  builder->next = layer ;
+
+  memset(builder->next, 0, builder->bytes) ;
+
+  builder->share = 0 ;
+  builder->depth++ ;
+  builder->reached += total ;
+  builder->stop = (total == 0) ;
+
+  if(total > 0){
+    printf("Depth %2d: %11ld entries (%5.1f%%)\n", \
+    builder->depth, total, (100.0 * builder->reached) / \
+    builder->pdb->entries) ;
+
+    fflush(stdout) ;
+  }
+
+  return ;
+}
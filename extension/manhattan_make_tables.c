@@ -0,0 +1,361 @@
+/*
+ * Generates manhattan_tables.h for the extension of 8-tile,
+ * run by the makefile before it is compiled. The tables only
+ * depend on the size of the board (tiles are relabelled to
+ * suit each goal), so are worked out once here rather than
+ * on every move. Tables are
+ * made for every size (height then width) given on the
+ * command line, each one inside an #if for that YS and XS, so
+ * a single header serves every size that is compiled. Writes
+ * the header to standard output.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include "manhattan_file_operations.h"
+#include "manhattan_board_operations.h"
+
+#define MAKE_TABLES_SIZE_ERROR "\nERROR: Board sizes should " \
+"be given as height width pairs, with at least two rows " \
+"and columns and at most %d cells.\n\n"
+
+#define MOVE_DIRECTIONS 4
+
+/* Each half of the packed solution, printed in hex. */
+#define HALF_BITS 32
+#define HALF_MASK 0xFFFFFFFFUL
+
+/* Most inversions of a board, ie (15 * 14) / 2 for 4x4. */
+#define MAX_INVERSIONS (((MAX_CELLS - 1) * (MAX_CELLS - 2)) / 2)
+
+/* Inversions are searched a little either side of 0 to max.*/
+#define INVERSION_SPAN (MAX_INVERSIONS + (4 * MAX_CELLS) + 1)
+#define UNREACHED -1
+
+void print_header(void) ;
+void print_size(int ys, int xs, int first) ;
+void print_footer(void) ;
+void print_goals(int ys, int xs) ;
+void print_distances(int ys, int xs) ;
+void print_neighbours(int ys, int xs) ;
+void print_solution(int ys, int xs) ;
+void print_place_values(int ys, int xs) ;
+void print_inversions(int ys, int xs) ;
+void inversion_moves(int most, int jump, int *moves) ;
+void print_row(int *row, int length, char *end) ;
+
+
+int main(int argc, char *argv[])
+{
+  int i, ys, xs ;
+
+  if((argc < 3) || (argc % 2 == 0)){
+    fprintf(stderr, MAKE_TABLES_SIZE_ERROR, MAX_CELLS) ;
+    exit(EXIT_FAILURE) ;
+  }
+
+  print_header() ;
+
+  for(i = 1 ; i < argc ; i += 2){
+    ys = atoi(argv[i]) ;
+    xs = atoi(argv[i + 1]) ;
+
+    if((ys < 2) || (xs < 2) || (ys * xs > MAX_CELLS)){
+      fprintf(stderr, MAKE_TABLES_SIZE_ERROR, MAX_CELLS) ;
+      exit(EXIT_FAILURE) ;
+    }
+
+    print_size(ys, xs, i == 1) ;
+
+    print_goals(ys, xs) ;
+
+    print_distances(ys, xs) ;
+
+    print_neighbours(ys, xs) ;
+
+    print_solution(ys, xs) ;
+
+    print_place_values(ys, xs) ;
+
+    print_inversions(ys, xs) ;
+  }
+
+  print_footer() ;
+
+  return 0 ;
+}
+
+void print_header(void)
+{
+  printf("/*\n * Generated by manhattan_make_tables.c - do not " \
+  "edit.\n */\n") ;
+
+  return ;
+}
+
+/* Each size is only seen when compiled for that size. */
+void print_size(int ys, int xs, int first)
+{
+  printf("%s (YS == %d) && (XS == %d)\n\n", first ? "#if" : \
+  "\n#elif", ys, xs) ;
+
+  return ;
+}
+
+/* Stops the tables being used with another board size. */
+void print_footer(void)
+{
+  printf("\n#else\n") ;
+  printf("#error \"manhattan_tables.h has no tables for this " \
+  "board size, add it to SIZES in the makefile.\"\n") ;
+  printf("#endif\n") ;
+
+  return ;
+}
+
+/*
+ * Row and column of the cell each tile belongs in. A tile's
+ * code is its cell in the goal, eg tile '1' is usually 0.
+ */
+void print_goals(int ys, int xs)
+{
+  int code, goal[MAX_CELLS] ;
+
+  for(code = 0 ; code < ys * xs ; code++){
+    goal[code] = code / xs ;
+  }
+
+  printf("/* Row of each tile (code) in the solution. */\n") ;
+  printf("static const int goal_y[%d] = ", ys * xs) ;
+  print_row(goal, ys * xs, " ;\n\n") ;
+
+  for(code = 0 ; code < ys * xs ; code++){
+    goal[code] = code % xs ;
+  }
+
+  printf("/* Column of each tile (code) in the solution. */\n") ;
+  printf("static const int goal_x[%d] = ", ys * xs) ;
+  print_row(goal, ys * xs, " ;\n\n") ;
+
+  return ;
+}
+
+/* 
+ * Distance of each tile (code) in each cell from its goal.
+ * Any code may be the blank, depending on the goal, so every
+ * row is filled and the blank's cell is skipped when read.
+ */
+void print_distances(int ys, int xs)
+{
+  int code, cell, distance[MAX_CELLS] ;
+
+  printf("/* Distance of tile (code) in cell from its goal. */\n") ;
+  printf("static const int distance_table[%d][%d] = {\n", \
+  ys * xs, ys * xs) ;
+
+  for(code = 0 ; code < ys * xs ; code++){
+    for(cell = 0 ; cell < ys * xs ; cell++){
+      distance[cell] = abs((code / xs) - (cell / xs)) + \
+      abs((code % xs) - (cell % xs)) ;
+    }
+
+    print_row(distance, ys * xs, \
+    (code == (ys * xs) - 1) ? "\n" : ",\n") ;
+  }
+
+  printf("} ;\n\n") ;
+
+  return ;
+}
+
+/*
+ * Cells N, W, E and S of each cell, ie in ascending order,
+ * which are the cells a tile can slide from into the blank.
+ */
+void print_neighbours(int ys, int xs)
+{
+  int cell, y, x, count[MAX_CELLS], i ;
+  int next[MAX_CELLS][MOVE_DIRECTIONS] ;
+
+  for(cell = 0 ; cell < ys * xs ; cell++){
+    y = cell / xs ;
+    x = cell % xs ;
+    count[cell] = 0 ;
+
+    for(i = 0 ; i < MOVE_DIRECTIONS ; i++){
+      next[cell][i] = 0 ;
+    }
+
+    if(y > 0){
+      next[cell][count[cell]++] = cell - xs ;
+    }
+    if(x > 0){
+      next[cell][count[cell]++] = cell - 1 ;
+    }
+    if(x < xs - 1){
+      next[cell][count[cell]++] = cell + 1 ;
+    }
+    if(y < ys - 1){
+      next[cell][count[cell]++] = cell + xs ;
+    }
+  }
+
+  printf("/* Number of cells next to each cell. */\n") ;
+  printf("static const int neighbour_count[%d] = ", ys * xs) ;
+  print_row(count, ys * xs, " ;\n\n") ;
+
+  printf("/* Cells next to each cell, in ascending order. */\n") ;
+  printf("static const int neighbour[%d][%d] = {\n", ys * xs, \
+  MOVE_DIRECTIONS) ;
+
+  for(cell = 0 ; cell < ys * xs ; cell++){
+    print_row(next[cell], MOVE_DIRECTIONS, \
+    (cell == (ys * xs) - 1) ? "\n" : ",\n") ;
+  }
+
+  printf("} ;\n\n") ;
+
+  return ;
+}
+
+/* Packed solution, ie code i in every cell i. */
+void print_solution(int ys, int xs)
+{
+  Packed board ;
+  int cell ;
+
+  board = 0 ;
+
+  for(cell = 0 ; cell < ys * xs ; cell++){
+    board |= (Packed)cell << (cell * CELL_BITS) ;
+  }
+
+  printf("/* Packed solution, ie code i in every cell i. */\n") ;
+  printf("#define PACKED_SOLUTION (((Packed)0x%lXUL << %d) | " \
+  "0x%lXUL)\n", (unsigned long)((board >> HALF_BITS) & \
+  HALF_MASK), HALF_BITS, (unsigned long)(board & HALF_MASK)) ;
+
+  return ;
+}
+
+/*
+ * Weight of each place in the Lehmer code of a board, ie
+ * (n - 1 - i)!, and n! boards in all. Only made for boards
+ * small enough to be ranked (see RANK_CELLS).
+ */
+void print_place_values(int ys, int xs)
+{
+  int i, place[MAX_CELLS] ;
+
+  if(ys * xs > RANK_CELLS){
+    return ;
+  }
+
+  place[(ys * xs) - 1] = 1 ;
+
+  for(i = (ys * xs) - 2 ; i >= 0 ; i--){
+    place[i] = place[i + 1] * ((ys * xs) - 1 - i) ;
+  }
+
+  printf("\n/* Number of boards, ie %d!. */\n", ys * xs) ;
+  printf("#define NUM_BOARDS %dUL\n\n", place[0] * ys * xs) ;
+
+  printf("/* Weight of each place in the Lehmer code. */\n") ;
+  printf("static const unsigned long place_value[%d] = ", \
+  ys * xs) ;
+  print_row(place, ys * xs, " ;\n") ;
+
+  return ;
+}
+
+/*
+ * Fewest moves that could undo the inversions of a board, in
+ * row order (tiles read across each row, then down) and in
+ * column order (down each column, then across). Only a move
+ * up or down changes the row order, as the tile jumps over
+ * the xs - 1 tiles between, so changes the inversions by at
+ * most xs - 1 (by xs - 1, xs - 3 and so on). Column order is
+ * the same with left and right, and ys - 1.
+ */
+void print_inversions(int ys, int xs)
+{
+  int most, moves[INVERSION_SPAN] ;
+
+  most = (((ys * xs) - 1) * ((ys * xs) - 2)) / 2 ;
+
+  inversion_moves(most, xs - 1, moves) ;
+
+  printf("\n/* Fewest moves up or down to undo i inversions in " \
+  "row order. */\n") ;
+  printf("static const int row_inversion_moves[%d] = ", \
+  most + 1) ;
+  print_row(moves, most + 1, " ;\n\n") ;
+
+  inversion_moves(most, ys - 1, moves) ;
+
+  printf("/* Fewest moves left or right to undo i inversions " \
+  "in column order. */\n") ;
+  printf("static const int column_inversion_moves[%d] = ", \
+  most + 1) ;
+  print_row(moves, most + 1, " ;\n") ;
+
+  return ;
+}
+
+/*
+ * Fewest steps of +/-jump, +/-(jump - 2) and so on (none of
+ * them 0) from each count of inversions, 0 to most, to 0. A
+ * breadth first search out from 0, which may pass below 0 or
+ * over most on the way (by up to 2 * jump). Any count that
+ * can not reach 0 is never a solvable board, so is left 0.
+ */
+void inversion_moves(int most, int jump, int *moves)
+{
+  int step[INVERSION_SPAN], queue[INVERSION_SPAN] ;
+  int i, head, tail, from, to, change, zero ;
+
+  zero = 2 * jump ;
+
+  for(i = 0 ; i < INVERSION_SPAN ; i++){
+    step[i] = UNREACHED ;
+  }
+
+  step[zero] = head = tail = 0 ;
+  queue[tail++] = zero ;
+
+  while(head < tail){
+    from = queue[head++] ;
+
+    for(change = -jump ; change <= jump ; change += 2){
+      to = from + change ;
+
+      if((change != 0) && (to >= 0) && \
+      (to <= most + (4 * jump)) && (step[to] == UNREACHED)){
+        step[to] = step[from] + 1 ;
+        queue[tail++] = to ;
+      }
+    }
+  }
+
+  for(i = 0 ; i <= most ; i++){
+    moves[i] = (step[zero + i] == UNREACHED) ? 0 : \
+    step[zero + i] ;
+  }
+
+  return ;
+}
+
+/* Prints one row of a table, ie {a, b, ...}, then end. */
+void print_row(int *row, int length, char *end)
+{
+  int i ;
+
+  printf("{") ;
+
+  for(i = 0 ; i < length ; i++){
+    printf("%s%d", (i == 0) ? "" : ", ", *(row + i)) ;
+  }
+
+  printf("}%s", end) ;
+
+  return ;
+}
@@ -0,0 +1,135 @@
+/*
+ * Header including the distance oracle for the extension of
+ * 8-tile. Every solvable board is labelled, offline, with its
+ * exact number of moves from the solution by a backwards BFS
+ * (see manhattan_make_oracle.c). The table is then mapped
+ * into memory, so a board can be solved by always moving to
+ * the child that is one move closer, with no search at all.
+ */
+#include <stdlib.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#define ORACLE_FILE_ERROR "\nERROR: Cannot open the distance " \
+"table: %s\nTry: make oracle\n\n"
+#define ORACLE_SIZE_ERROR "\nERROR: Distance table is not " \
+"the expected size: %s\n\n"
+#define ORACLE_MAP_ERROR "\nERROR: Unable to map the distance " \
+"table into memory: %s\n\n"
+
+#if (YS != 3) || (XS != 3)
+#error "The distance oracle is only defined for 3x3 boards."
+#endif
+
+/* Default file name of the table, made by 'make oracle'. */
+#define ORACLE_FILE "manhattan_oracle.bin"
+
+/*
+ * A board is indexed by its blank cell and the rank of its 8
+ * tiles (ignoring the blank). Ranks 2k and 2k+1 differ by one
+ * swap of two tiles, so only one of each pair is solvable and
+ * rank / 2 is enough. Hence 9 * 8! / 2 = 181440 boards.
+ */
+#define TILE_PERMS 40320
+#define ORACLE_STATES (NUM_TILES * (TILE_PERMS / 2))
+
+/* Distance is stored mod 16, ie 4 bits, two per byte. */
+#define ORACLE_BITS 4
+#define ORACLE_MASK 0xF
+#define ORACLE_BYTES (ORACLE_STATES / 2)
+
+/* Distance (mod 16) of board with index i. */
+#define ORACLE_ENTRY(oracle, i) \
+((oracle[(i) >> 1] >> (((i) & 1) * ORACLE_BITS)) & ORACLE_MASK)
+
+INTERNAL long oracle_index(Packed board, int blank) ;
+INTERNAL int oracle_distance(unsigned char *oracle, \
+Packed board, int blank) ;
+INTERNAL int load_oracle(const char *file, \
+unsigned char **oracle) ;
+INTERNAL void free_oracle(unsigned char *oracle) ;
+
+
+/*
+ * Place of a board in the table. Tiles are ranked as in
+ * board_rank, with the blank's code used from the start, so
+ * it is never counted. With one digit fewer, the weight of
+ * each place is that of the next place of a board, ie
+ * place_value[place + 1] (see manhattan_tables.h).
+ */
+INTERNAL long oracle_index(Packed board, int blank)
+{
+  unsigned long rank ;
+  unsigned int used, digit ;
+  int i, place ;
+
+  rank = 0 ;
+  used = 1U << CELL(board, blank) ;
+  place = 0 ;
+
+  for(i = 0 ; i < NUM_TILES ; i++){
+    if(i != blank){
+      digit = CELL(board, i) ;
+
+      /* Number of smaller digits that are still unused. */
+      rank += (digit - __builtin_popcount(used & \
+      ((1U << digit) - 1))) * place_value[++place] ;
+
+      used |= 1U << digit ;
+    }
+  }
+
+  return (blank * (TILE_PERMS / 2)) + (long)(rank / 2) ;
+}
+
+/* Moves (mod 16) from board to the solution. */
+INTERNAL int oracle_distance(unsigned char *oracle, \
+Packed board, int blank)
+{
+  long i ;
+
+  i = oracle_index(board, blank) ;
+
+  return ORACLE_ENTRY(oracle, i) ;
+}
+
+/* Maps the table made by manhattan_make_oracle.c (read only).*/
+INTERNAL int load_oracle(const char *file, \
+unsigned char **oracle)
+{
+  struct stat info ;
+  void *map ;
+  int fd ;
+
+  if((fd = open(file, O_RDONLY)) < 0){
+    return SOLVER_ORACLE_FILE_ERROR ;
+  }
+
+  if((fstat(fd, &info) != 0) || \
+  (info.st_size != ORACLE_BYTES)){
+    close(fd) ;
+    return SOLVER_ORACLE_SIZE_ERROR ;
+  }
+
+  map = mmap(NULL, ORACLE_BYTES, PROT_READ, MAP_SHARED, fd, 0) ;
+
+  /* Mapping stays valid once the file is closed. */
+  close(fd) ;
+
+  if(map == MAP_FAILED){
+    return SOLVER_ORACLE_MAP_ERROR ;
+  }
+
+  *oracle = (unsigned char *)map ;
+
+  return SOLVER_OK ;
+}
+
+INTERNAL void free_oracle(unsigned char *oracle)
+{
+  munmap(oracle, ORACLE_BYTES) ;
+
+  return ;
+}
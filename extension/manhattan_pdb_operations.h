@@ -0,0 +1,619 @@
+/*
+ * Header including the additive pattern databases for the
+ * extension of 8-tile. A pattern is some of the tiles (by
+ * code, ie their cell at the goal), and its table holds the
+ * fewest moves of those tiles alone to take them from any
+ * cells to their goal cells (other tiles are ignored, so the
+ * blank can be anywhere). Each move only moves one tile, so
+ * the tables of patterns with no tile in common are added.
+ * The tables are made offline (see manhattan_make_pdb.c) and
+ * mapped into memory read only, so they load at once and are
+ * shared, through the page cache, by every solver running.
+ * They can be compressed (see manhattan_compress_pdb.c) to
+ * 4 bits per entry, holding half the moves over the Manhattan
+ * distance of the pattern's tiles, or to 2 bits, holding the
+ * moves modulo 3 (a move of a pattern tile is always one more
+ * or one less, so the moves before it tell which). Either may
+ * also keep only the least of every k entries next to each
+ * other, which still never over-estimates.
+ */
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#define PDB_FILE_ERROR "\nERROR: Cannot open the pattern " \
+"database: %s\nTry: make pdb\n\n"
+#define PDB_SIZE_ERROR "\nERROR: Pattern database is not " \
+"for this board size, or is not the expected size: %s\n\n"
+#define PDB_MAP_ERROR "\nERROR: Unable to map the pattern " \
+"database into memory: %s\n\n"
+#define PDB_PARTITION_ERROR "\nERROR: Pattern databases " \
+"share a tile, include the blank of the goal, or there are " \
+"more than " PDB_TEXT(PDB_LIMIT) " of them.\n\n"
+#define PDB_MEMORY_ERROR "\nERROR: Unable to allocate space " \
+"for the pattern databases.\n\n"
+#define PDB_WRITE_ERROR "\nERROR: Cannot write the pattern " \
+"database: %s\n\n"
+
+/*
+ * Most tables that can be added (each board holds the moves
+ * of each, a byte apiece, in 64 bits), and separator of files.
+ */
+#define PDB_LIMIT 8
+#define PDB_SEPARATOR ','
+
+/* Limit as text, for the error message. */
+#define PDB_STRING(n) #n
+#define PDB_TEXT(n) PDB_STRING(n)
+
+/* Moves of table i, in the parts a board holds. */
+#define PART(parts, i) ((int)(((parts) >> ((i) << 3)) & 0xFF))
+#define SET_PART(parts, i, moves) (((parts) & \
+~((Packed)0xFF << ((i) << 3))) | ((Packed)(moves) << ((i) << 3)))
+
+/* Written first, then renamed to the file asked for. */
+#define TEMP_SUFFIX ".tmp"
+
+/* Code is in no pattern. */
+#define PDB_NONE -1
+
+/* Table entry of a pattern never reached while built. */
+#define PDB_UNREACHED 0xFF
+
+/* Formats of a table: 8, 4 or 2 bits per value kept. */
+#define PDB_BYTES 0
+#define PDB_NIBBLES 1
+#define PDB_MOD3 2
+
+/* Most a nibble holds, of half the moves over the distance. */
+#define NIBBLE_LIMIT 15
+
+/*
+ * File: a header of ints (a tag, the height and width, the
+ * format, the entries each value kept is the least of, if
+ * every value is exact, the number of tiles and their codes),
+ * then the values kept, packed in the format.
+ */
+#define PDB_TAG 0x50444232
+#define PDB_FORMAT 3
+#define PDB_GROUP 4
+#define PDB_EXACT 5
+#define PDB_CODES 7
+#define PDB_HEADER_INTS (PDB_CODES + MAX_CELLS)
+#define PDB_HEADER_BYTES (PDB_HEADER_INTS * sizeof(int))
+
+/*
+ * Pdb: one mapped table. Tiles of the pattern are in cells
+ * p0, p1 ... and the entry is the rank of that arrangement,
+ * ie the sum of each pi's place among the cells not used by
+ * p0 ... pi-1, times place[i] (the arrangements of the rest).
+ * Entry i is value i / group of those kept (stored).
+ */
+struct pdb{
+  unsigned char *map ;
+  unsigned char *table ;
+  size_t size ;
+  long entries ;
+  long stored ;
+  int format ;
+  int group ;
+  int exact ;
+  int tiles ;
+  int code[MAX_CELLS] ;
+  long place[MAX_CELLS] ;
+} ;
+typedef struct pdb Pdb ;
+
+/*
+ * Pdb_Set: tables added together, the one each code is in,
+ * and if every table holds the exact moves.
+ */
+struct pdb_set{
+  Pdb pdb[PDB_LIMIT] ;
+  int count ;
+  int exact ;
+  int owner[MAX_CELLS] ;
+} ;
+typedef struct pdb_set Pdb_Set ;
+
+INTERNAL long pdb_entries(int tiles) ;
+INTERNAL void pdb_places(Pdb *pdb) ;
+INTERNAL long pdb_bytes(Pdb *pdb) ;
+INTERNAL long pdb_index(Pdb *pdb, int *cell) ;
+INTERNAL void pdb_cells(Pdb *pdb, long index, int *cell) ;
+INTERNAL int pdb_stored(Pdb *pdb, unsigned char *table, \
+long index) ;
+INTERNAL int pdb_manhattan(Pdb *pdb, int *cell) ;
+INTERNAL int pdb_decode(Pdb *pdb, int *cell, int last) ;
+INTERNAL int pdb_distance(Pdb *pdb, Packed board, int last) ;
+INTERNAL int pdb_reconstruct(Pdb *pdb, Packed board) ;
+INTERNAL int pdb_function(Pdb_Set *set, Packed board, \
+Packed *parts) ;
+INTERNAL int load_pdbs(const char *files, int blank, \
+Pdb_Set **set, const char **failed) ;
+INTERNAL int load_pdb(Pdb *pdb, const char *file) ;
+INTERNAL int save_pdb(Pdb *pdb, unsigned char *table, \
+char *file) ;
+INTERNAL void free_pdbs(Pdb_Set *set) ;
+INTERNAL char *pdb_message(int status) ;
+
+
+/* Arrangements of tiles in the cells, ie n! / (n - tiles)!.*/
+INTERNAL long pdb_entries(int tiles)
+{
+  long entries ;
+  int i ;
+
+  entries = 1 ;
+
+  for(i = 0 ; i < tiles ; i++){
+    entries *= NUM_TILES - i ;
+  }
+
+  return entries ;
+}
+
+/*
+ * Weight of each tile's place, and the size of the table
+ * (its tiles and group are already set).
+ */
+INTERNAL void pdb_places(Pdb *pdb)
+{
+  int i ;
+
+  pdb->entries = pdb_entries(pdb->tiles) ;
+  pdb->stored = (pdb->entries + pdb->group - 1) / pdb->group ;
+
+  pdb->place[pdb->tiles - 1] = 1 ;
+
+  for(i = pdb->tiles - 2 ; i >= 0 ; i--){
+    pdb->place[i] = pdb->place[i + 1] * \
+    (NUM_TILES - 1 - i) ;
+  }
+
+  return ;
+}
+
+/* Bytes the values kept take, packed in the table's format.*/
+INTERNAL long pdb_bytes(Pdb *pdb)
+{
+  if(pdb->format == PDB_NIBBLES){
+    return (pdb->stored + 1) / 2 ;
+  }
+
+  if(pdb->format == PDB_MOD3){
+    return (pdb->stored + 3) / 4 ;
+  }
+
+  return pdb->stored ;
+}
+
+/*
+ * Entry for the tiles of the pattern in cells (indexed by
+ * code). Used cells are a bitmask, so each place is the cell
+ * less the used cells below it.
+ */
+INTERNAL long pdb_index(Pdb *pdb, int *cell)
+{
+  long index ;
+  unsigned int used ;
+  int i, c ;
+
+  index = 0 ;
+  used = 0 ;
+
+  for(i = 0 ; i < pdb->tiles ; i++){
+    c = cell[pdb->code[i]] ;
+
+    index += (c - __builtin_popcount(used & ((1U << c) - 1))) \
+    * pdb->place[i] ;
+
+    used |= 1U << c ;
+  }
+
+  return index ;
+}
+
+/* Inverse of pdb_index, cells (indexed by code) of entry. */
+INTERNAL void pdb_cells(Pdb *pdb, long index, int *cell)
+{
+  unsigned int used ;
+  int i, c, place ;
+
+  used = 0 ;
+
+  for(i = 0 ; i < pdb->tiles ; i++){
+    place = (int)(index / pdb->place[i]) ;
+    index %= pdb->place[i] ;
+
+    /* Place-th cell not yet used. */
+    for(c = 0 ; (used & (1U << c)) || (place-- > 0) ; c++) ;
+
+    cell[pdb->code[i]] = c ;
+    used |= 1U << c ;
+  }
+
+  return ;
+}
+
+/* Value kept for entry index of table (in pdb's format). */
+INTERNAL int pdb_stored(Pdb *pdb, unsigned char *table, \
+long index)
+{
+  index /= pdb->group ;
+
+  if(pdb->format == PDB_NIBBLES){
+    return (table[index >> 1] >> ((index & 1) << 2)) & 0xF ;
+  }
+
+  if(pdb->format == PDB_MOD3){
+    return (table[index >> 2] >> ((index & 3) << 1)) & 0x3 ;
+  }
+
+  return table[index] ;
+}
+
+/* Manhattan distance of the pattern's tiles in cell. */
+INTERNAL int pdb_manhattan(Pdb *pdb, int *cell)
+{
+  int i, moves ;
+
+  moves = 0 ;
+
+  for(i = 0 ; i < pdb->tiles ; i++){
+    moves += distance_table[pdb->code[i]][cell[pdb->code[i]]] ;
+  }
+
+  return moves ;
+}
+
+/*
+ * Moves of the pattern's tiles in cell to the goal. Last is
+ * the moves one move of a pattern tile before (only needed
+ * for moves modulo 3).
+ */
+INTERNAL int pdb_decode(Pdb *pdb, int *cell, int last)
+{
+  int value ;
+
+  value = pdb_stored(pdb, pdb->table, pdb_index(pdb, cell)) ;
+
+  if(pdb->format == PDB_NIBBLES){
+    return pdb_manhattan(pdb, cell) + (2 * value) ;
+  }
+
+  if(pdb->format == PDB_MOD3){
+    return ((last + 1) % 3 == value) ? (last + 1) : (last - 1) ;
+  }
+
+  return value ;
+}
+
+/* As pdb_decode, for the pattern's tiles on board. */
+INTERNAL int pdb_distance(Pdb *pdb, Packed board, int last)
+{
+  int i, cell[MAX_CELLS] ;
+
+  /* Blank's code is never in a pattern (see load_pdbs). */
+  for(i = 0 ; i < NUM_TILES ; i++){
+    cell[CELL(board, i)] = i ;
+  }
+
+  return pdb_decode(pdb, cell, last) ;
+}
+
+/*
+ * Moves of the pattern's tiles on board to the goal, for a
+ * table of moves modulo 3: a move to where they are one less
+ * (modulo 3) is always one closer, so these are followed to
+ * the goal and counted.
+ */
+INTERNAL int pdb_reconstruct(Pdb *pdb, Packed board)
+{
+  unsigned int used ;
+  int i, j, code, from, to, moves, value, found ;
+  int cell[MAX_CELLS] ;
+
+  for(i = 0 ; i < NUM_TILES ; i++){
+    cell[CELL(board, i)] = i ;
+  }
+
+  for(moves = 0 ; ; moves++){
+    used = 0 ;
+    found = 0 ;
+
+    for(i = 0 ; i < pdb->tiles ; i++){
+      used |= 1U << cell[pdb->code[i]] ;
+      found += (cell[pdb->code[i]] == pdb->code[i]) ;
+    }
+
+    if(found == pdb->tiles){
+      return moves ;
+    }
+
+    value = pdb_stored(pdb, pdb->table, pdb_index(pdb, cell)) ;
+    found = 0 ;
+
+    for(i = 0 ; !found && (i < pdb->tiles) ; i++){
+      code = pdb->code[i] ;
+      from = cell[code] ;
+
+      for(j = 0 ; !found && (j < neighbour_count[from]) ; j++){
+        to = neighbour[from][j] ;
+
+        if(!(used & (1U << to))){
+          cell[code] = to ;
+
+          found = (pdb_stored(pdb, pdb->table, \
+          pdb_index(pdb, cell)) == (value + 2) % 3) ;
+        }
+      }
+
+      if(!found){
+        cell[code] = from ;
+      }
+    }
+  }
+}
+
+/*
+ * Sum of every table, ie the pattern database heuristic, with
+ * the moves of each kept in parts.
+ */
+INTERNAL int pdb_function(Pdb_Set *set, Packed board, \
+Packed *parts)
+{
+  int i, moves, sum ;
+
+  sum = 0 ;
+  *parts = 0 ;
+
+  for(i = 0 ; i < set->count ; i++){
+    moves = (set->pdb[i].format == PDB_MOD3) ? \
+    pdb_reconstruct(&set->pdb[i], board) : \
+    pdb_distance(&set->pdb[i], board, 0) ;
+
+    *parts = SET_PART(*parts, i, moves) ;
+    sum += moves ;
+  }
+
+  return sum ;
+}
+
+/*
+ * Maps every table in the list (files separated by commas).
+ * No two may share a tile, and none may hold the blank of the
+ * goal (blank). Each name is copied out of the list, which is
+ * never changed, and if a table fails, failed is left at the
+ * start of its name there.
+ */
+INTERNAL int load_pdbs(const char *files, int blank, \
+Pdb_Set **set, const char **failed)
+{
+  Pdb *pdb ;
+  char name[FILENAME_MAX] ;
+  const char *file, *next ;
+  size_t length ;
+  int i, j, status ;
+
+  if((*set = (Pdb_Set *)malloc(sizeof(Pdb_Set))) == NULL){
+    return SOLVER_MEMORY_ERROR ;
+  }
+
+  (*set)->count = 0 ;
+  (*set)->exact = 1 ;
+
+  for(i = 0 ; i < MAX_CELLS ; i++){
+    (*set)->owner[i] = PDB_NONE ;
+  }
+
+  for(file = files ; file != NULL ; file = next){
+    if((next = strchr(file, PDB_SEPARATOR)) != NULL){
+      length = (size_t)(next++ - file) ;
+    }
+
+    else{
+      length = strlen(file) ;
+    }
+
+    /* Empty names, as between two commas, are skipped. */
+    if(length == 0){
+      status = SOLVER_OK ;
+    }
+
+    else if(length >= FILENAME_MAX){
+      status = SOLVER_PDB_FILE_ERROR ;
+    }
+
+    else if((*set)->count == PDB_LIMIT){
+      status = SOLVER_PDB_PARTITION_ERROR ;
+    }
+
+    else{
+      pdb = &(*set)->pdb[(*set)->count] ;
+
+      memcpy(name, file, length) ;
+      name[length] = '\0' ;
+
+      if((status = load_pdb(pdb, name)) == SOLVER_OK){
+        (*set)->count++ ;
+      }
+
+      for(j = 0 ; (status == SOLVER_OK) && (j < pdb->tiles) ; \
+      j++){
+        i = pdb->code[j] ;
+
+        if(((*set)->owner[i] != PDB_NONE) || (i == blank)){
+          status = SOLVER_PDB_PARTITION_ERROR ;
+        }
+
+        (*set)->owner[i] = (*set)->count - 1 ;
+      }
+
+      (*set)->exact = (*set)->exact && pdb->exact ;
+    }
+
+    if(status != SOLVER_OK){
+      *failed = file ;
+      free_pdbs(*set) ;
+      *set = NULL ;
+      return status ;
+    }
+  }
+
+  return SOLVER_OK ;
+}
+
+/* Maps a table made by manhattan_make_pdb.c (read only). */
+INTERNAL int load_pdb(Pdb *pdb, const char *file)
+{
+  struct stat info ;
+  int header[PDB_HEADER_INTS] ;
+  void *map ;
+  int fd, i ;
+
+  if((fd = open(file, O_RDONLY)) < 0){
+    return SOLVER_PDB_FILE_ERROR ;
+  }
+
+  if((fstat(fd, &info) != 0) || \
+  (info.st_size < (off_t)PDB_HEADER_BYTES)){
+    close(fd) ;
+    return SOLVER_PDB_SIZE_ERROR ;
+  }
+
+  map = mmap(NULL, info.st_size, PROT_READ, MAP_SHARED, fd, 0) ;
+
+  /* Mapping stays valid once the file is closed. */
+  close(fd) ;
+
+  if(map == MAP_FAILED){
+    return SOLVER_PDB_MAP_ERROR ;
+  }
+
+  memcpy(header, map, PDB_HEADER_BYTES) ;
+
+  pdb->map = (unsigned char *)map ;
+  pdb->table = pdb->map + PDB_HEADER_BYTES ;
+  pdb->size = info.st_size ;
+  pdb->format = header[PDB_FORMAT] ;
+  pdb->group = header[PDB_GROUP] ;
+  pdb->exact = header[PDB_EXACT] ;
+  pdb->tiles = header[PDB_CODES - 1] ;
+
+  if((header[0] != PDB_TAG) || (header[1] != YS) || \
+  (header[2] != XS) || (pdb->tiles < 1) || \
+  (pdb->tiles > NUM_WO_BLANK) || (pdb->format < PDB_BYTES) || \
+  (pdb->format > PDB_MOD3) || (pdb->group < 1) || \
+  ((pdb->format == PDB_MOD3) && (pdb->group != 1))){
+    munmap(map, pdb->size) ;
+    return SOLVER_PDB_SIZE_ERROR ;
+  }
+
+  for(i = 0 ; i < pdb->tiles ; i++){
+    pdb->code[i] = header[PDB_CODES + i] ;
+
+    if((pdb->code[i] < 0) || (pdb->code[i] >= NUM_TILES)){
+      munmap(map, pdb->size) ;
+      return SOLVER_PDB_SIZE_ERROR ;
+    }
+  }
+
+  pdb_places(pdb) ;
+
+  if(pdb->size != PDB_HEADER_BYTES + (size_t)pdb_bytes(pdb)){
+    munmap(map, pdb->size) ;
+    return SOLVER_PDB_SIZE_ERROR ;
+  }
+
+  return SOLVER_OK ;
+}
+
+/*
+ * Writes the header, then the table, to file with TEMP_SUFFIX
+ * added, and renames it to file once it is complete, so no
+ * solver ever maps half of one.
+ */
+INTERNAL int save_pdb(Pdb *pdb, unsigned char *table, \
+char *file)
+{
+  FILE *out ;
+  char *temp ;
+  int i, header[PDB_HEADER_INTS] = {0} ;
+
+  header[0] = PDB_TAG ;
+  header[1] = YS ;
+  header[2] = XS ;
+  header[PDB_FORMAT] = pdb->format ;
+  header[PDB_GROUP] = pdb->group ;
+  header[PDB_EXACT] = pdb->exact ;
+  header[PDB_CODES - 1] = pdb->tiles ;
+
+  for(i = 0 ; i < pdb->tiles ; i++){
+    header[PDB_CODES + i] = pdb->code[i] ;
+  }
+
+  temp = (char *)malloc(strlen(file) + strlen(TEMP_SUFFIX) + 1) ;
+
+  if(temp == NULL){
+    return SOLVER_MEMORY_ERROR ;
+  }
+
+  strcpy(temp, file) ;
+  strcat(temp, TEMP_SUFFIX) ;
+
+  if((out = fopen(temp, "wb")) == NULL){
+    free(temp) ;
+    return SOLVER_PDB_WRITE_ERROR ;
+  }
+
+  if((fwrite(header, sizeof(int), PDB_HEADER_INTS, out) != \
+  PDB_HEADER_INTS) || (fwrite(table, sizeof(unsigned char), \
+  pdb_bytes(pdb), out) != (size_t)pdb_bytes(pdb)) || \
+  (fflush(out) != 0) || (fsync(fileno(out)) != 0)){
+    fclose(out) ;
+    remove(temp) ;
+    free(temp) ;
+    return SOLVER_PDB_WRITE_ERROR ;
+  }
+
+  /* A solver that mapped the old file keeps the old table. */
+  if((fclose(out) != 0) || (rename(temp, file) != 0)){
+    remove(temp) ;
+    free(temp) ;
+    return SOLVER_PDB_WRITE_ERROR ;
+  }
+
+  free(temp) ;
+
+  return SOLVER_OK ;
+}
+
+INTERNAL void free_pdbs(Pdb_Set *set)
+{
+  int i ;
+
+  for(i = 0 ; i < set->count ; i++){
+    munmap(set->pdb[i].map, set->pdb[i].size) ;
+  }
+
+  free(set) ;
+
+  return ;
+}
+
+/* Message of a status of the tables, given the file's name. */
+INTERNAL char *pdb_message(int status)
+{
+  switch(status){
+    case SOLVER_PDB_FILE_ERROR : return PDB_FILE_ERROR ;
+    case SOLVER_PDB_SIZE_ERROR : return PDB_SIZE_ERROR ;
+    case SOLVER_PDB_MAP_ERROR : return PDB_MAP_ERROR ;
+    case SOLVER_PDB_PARTITION_ERROR : return PDB_PARTITION_ERROR ;
+    case SOLVER_PDB_WRITE_ERROR : return PDB_WRITE_ERROR ;
+    default : return PDB_MEMORY_ERROR ;
+  }
+}
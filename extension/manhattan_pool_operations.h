@@ -0,0 +1,216 @@
+/*
+ * Header including the work-stealing thread pool used by the
+ * extension of 8-tile to solve a list of boards in parallel.
+ * Items (boards) are split evenly between the threads, each
+ * taking from the front of its own deque. A thread that runs
+ * out steals the back half of another thread's deque, so the
+ * work stays balanced however long each board takes. Each
+ * thread has its own state (see Solver), so only the deques
+ * are ever shared. A thread that cannot be started leaves its
+ * items to be stolen, so they are still all done.
+ */
+#include <stdlib.h>
+#include <pthread.h>
+
+/* Returned by next_item once every deque is empty. */
+#define NO_ITEM -1
+
+/* Work done for each item, with the thread's own state. */
+typedef void (*Pool_Task)(void *state, int item) ;
+
+/* Deque: items head to tail - 1 are still to be done. */
+struct deque{
+  pthread_mutex_t lock ;
+  int head ;
+  int tail ;
+} ;
+typedef struct deque Deque ;
+
+/* Pool: a deque and a state for each thread. */
+struct pool{
+  Deque *deque ;
+  void **state ;
+  Pool_Task task ;
+  int threads ;
+} ;
+typedef struct pool Pool ;
+
+/* Worker: what each thread is started with. */
+struct worker{
+  Pool *pool ;
+  int id ;
+} ;
+typedef struct worker Worker ;
+
+INTERNAL int create_pool(Pool *pool, int threads, \
+void **state, Pool_Task task) ;
+INTERNAL int run_pool(Pool *pool, int items) ;
+INTERNAL void *pool_worker(void *arg) ;
+INTERNAL int next_item(Pool *pool, int id) ;
+INTERNAL int steal_items(Pool *pool, int id) ;
+INTERNAL void free_pool(Pool *pool) ;
+
+
+INTERNAL int create_pool(Pool *pool, int threads, \
+void **state, Pool_Task task)
+{
+  int i ;
+
+  pool->deque = (Deque *)malloc(threads * sizeof(Deque)) ;
+
+  if(pool->deque == NULL){
+    return SOLVER_MEMORY_ERROR ;
+  }
+
+  for(i = 0 ; i < threads ; i++){
+    pthread_mutex_init(&pool->deque[i].lock, NULL) ;
+    pool->deque[i].head = pool->deque[i].tail = 0 ;
+  }
+
+  pool->state = state ;
+  pool->task = task ;
+  pool->threads = threads ;
+
+  return SOLVER_OK ;
+}
+
+/*
+ * Does items 0 to items - 1, returning once all are done.
+ * The calling thread works as thread 0, so one thread needs
+ * no others to be started.
+ */
+INTERNAL int run_pool(Pool *pool, int items)
+{
+  pthread_t *thread ;
+  Worker *worker ;
+  int i, started ;
+
+  thread = (pthread_t *)malloc(pool->threads * \
+  sizeof(pthread_t)) ;
+
+  worker = (Worker *)malloc(pool->threads * sizeof(Worker)) ;
+
+  if((thread == NULL) || (worker == NULL)){
+    free(thread) ;
+    free(worker) ;
+    return SOLVER_MEMORY_ERROR ;
+  }
+
+  /* Contiguous share for each, so neighbours stay together.*/
+  for(i = 0 ; i < pool->threads ; i++){
+    pool->deque[i].head = (int)(((long)items * i) / \
+    pool->threads) ;
+    pool->deque[i].tail = (int)(((long)items * (i + 1)) / \
+    pool->threads) ;
+
+    worker[i].pool = pool ;
+    worker[i].id = i ;
+  }
+
+  for(started = 1 ; (started < pool->threads) && \
+  (pthread_create(&thread[started], NULL, pool_worker, \
+  &worker[started]) == 0) ; started++) ;
+
+  pool_worker(&worker[0]) ;
+
+  for(i = 1 ; i < started ; i++){
+    pthread_join(thread[i], NULL) ;
+  }
+
+  free(worker) ;
+  free(thread) ;
+
+  return SOLVER_OK ;
+}
+
+/* Does items until there are none left to do or steal. */
+INTERNAL void *pool_worker(void *arg)
+{
+  Worker *worker ;
+  int item ;
+
+  worker = (Worker *)arg ;
+
+  while((item = next_item(worker->pool, worker->id)) != \
+  NO_ITEM){
+    worker->pool->task(worker->pool->state[worker->id], item) ;
+  }
+
+  return NULL ;
+}
+
+/* Front of the thread's own deque, or else a stolen item. */
+INTERNAL int next_item(Pool *pool, int id)
+{
+  Deque *own ;
+  int item ;
+
+  own = &pool->deque[id] ;
+
+  pthread_mutex_lock(&own->lock) ;
+
+  item = (own->head < own->tail) ? own->head++ : NO_ITEM ;
+
+  pthread_mutex_unlock(&own->lock) ;
+
+  if(item == NO_ITEM){
+    item = steal_items(pool, id) ;
+  }
+
+  return item ;
+}
+
+/*
+ * Takes the back half of the first other deque with items
+ * left (starting from the next thread), keeps them in its
+ * own deque and returns the first. No new items are made, so
+ * once every deque is found empty the thread can finish.
+ */
+INTERNAL int steal_items(Pool *pool, int id)
+{
+  Deque *victim, *own ;
+  int i, first, last ;
+
+  own = &pool->deque[id] ;
+
+  for(i = 1 ; i < pool->threads ; i++){
+    victim = &pool->deque[(id + i) % pool->threads] ;
+
+    pthread_mutex_lock(&victim->lock) ;
+
+    first = victim->head + ((victim->tail - victim->head) / 2) ;
+    last = victim->tail ;
+
+    if(first < last){
+      victim->tail = first ;
+    }
+
+    pthread_mutex_unlock(&victim->lock) ;
+
+    if(first < last){
+      pthread_mutex_lock(&own->lock) ;
+
+      own->head = first + 1 ;
+      own->tail = last ;
+
+      pthread_mutex_unlock(&own->lock) ;
+
+      return first ;
+    }
+  }
+
+  return NO_ITEM ;
+}
+
+INTERNAL void free_pool(Pool *pool)
+{
+  int i ;
+
+  for(i = 0 ; i < pool->threads ; i++){
+    pthread_mutex_destroy(&pool->deque[i].lock) ;
+  }
+
+  free(pool->deque) ;
+
+  return ;
+}
@@ -0,0 +1,188 @@
+/*
+ * Header including the open list (priority queue) used by
+ * the A* search in the extension of 8-tile. Boards are kept
+ * in buckets indexed by their Manhattan priority, f = g + h,
+ * and the number of moves made so far, g. As both are small
+ * integers, pushing and popping a board is O(1).
+ */
+#include <stdlib.h>
+
+#define QUEUE_RANGE_ERROR "\nERROR: Priority of board is " \
+"outside of the range of the open list.\n\n"
+
+/*
+ * Upper bounds (exclusive) of f and g. For 3x3 boards, the
+ * longest solution is 31 moves and h is at most 24, so any
+ * queued board has f no greater than 31 + 2. For 4x4 the
+ * longest solution is 80 moves, so f is no more than 82.
+ */
+#define F_LIMIT 128
+#define G_LIMIT 128
+
+/* Initial number of boards each bucket can hold. */
+#define BUCKET_START 16
+
+/* Returned by pop_board when the open list is empty. */
+#define EMPTY_QUEUE -1
+
+/* Bucket: stack of boards with the same values of f and g.*/
+struct bucket{
+  int *board ;
+  int count ;
+  int size ;
+} ;
+typedef struct bucket Bucket ;
+
+/*
+ * Open_List: every board waiting to be expanded. min_f is
+ * the lowest f that could still hold a board, and max_f the
+ * highest f that any board has been pushed with.
+ *
+ * Tie-break policy, given equal f: the board with the larger
+ * g is popped first (closest to the solution), then given
+ * equal g, the most recently pushed board is popped first.
+ * Hence, a child with the same priority as its parent is
+ * expanded straight after it.
+ */
+struct open_list{
+  Bucket bucket[F_LIMIT][G_LIMIT] ;
+  int min_f ;
+  int max_f ;
+  int count ;
+} ;
+typedef struct open_list Open_List ;
+
+INTERNAL void create_open_list(Open_List *open) ;
+INTERNAL int push_board(Open_List *open, int board, int f, \
+int g) ;
+INTERNAL int pop_board(Open_List *open) ;
+INTERNAL void reset_open_list(Open_List *open) ;
+INTERNAL void free_open_list(Open_List *open) ;
+
+
+/* Every bucket starts empty and unallocated. */
+INTERNAL void create_open_list(Open_List *open)
+{
+  int f, g ;
+
+  for(f = 0 ; f < F_LIMIT ; f++){
+    for(g = 0 ; g < G_LIMIT ; g++){
+      open->bucket[f][g].board = NULL ;
+      open->bucket[f][g].count = 0 ;
+      open->bucket[f][g].size = 0 ;
+    }
+  }
+
+  open->min_f = F_LIMIT ;
+  open->max_f = -1 ;
+  open->count = 0 ;
+
+  return ;
+}
+
+/* Adds board to top of the bucket for its values f and g. */
+INTERNAL int push_board(Open_List *open, int board, int f, \
+int g)
+{
+  Bucket *b ;
+  int *grown, size ;
+
+  if((f < 0) || (f >= F_LIMIT) || (g < 0) || \
+  (g >= G_LIMIT)){
+    return SOLVER_RANGE_ERROR ;
+  }
+
+  b = &open->bucket[f][g] ;
+
+  /* Double the size of the bucket whenever it is full. */
+  if(b->count == b->size){
+    size = (b->size == 0) ? BUCKET_START : (2 * b->size) ;
+
+    grown = (int *)realloc(b->board, size * sizeof(int)) ;
+
+    if(grown == NULL){
+      return SOLVER_MEMORY_ERROR ;
+    }
+
+    b->board = grown ;
+    b->size = size ;
+  }
+
+  b->board[b->count++] = board ;
+
+  if(f < open->min_f){
+    open->min_f = f ;
+  }
+
+  if(f > open->max_f){
+    open->max_f = f ;
+  }
+
+  open->count++ ;
+
+  return SOLVER_OK ;
+}
+
+/* Removes board with lowest f (see tie-break policy). */
+INTERNAL int pop_board(Open_List *open)
+{
+  Bucket *b ;
+  int g ;
+
+  if(open->count == 0){
+    return EMPTY_QUEUE ;
+  }
+
+  /* As g <= f, only buckets with g up to f can be filled. */
+  while(1){
+    for(g = open->min_f ; g >= 0 ; g--){
+      if(g < G_LIMIT){
+        b = &open->bucket[open->min_f][g] ;
+
+        if(b->count > 0){
+          open->count-- ;
+
+          return b->board[--b->count] ;
+        }
+      }
+    }
+
+    open->min_f++ ;
+  }
+}
+
+/*
+ * Empties the open list, ready for another search, but keeps
+ * the space of every bucket. Only buckets between min_f and
+ * max_f can still hold a board.
+ */
+INTERNAL void reset_open_list(Open_List *open)
+{
+  int f, g ;
+
+  for(f = open->min_f ; f <= open->max_f ; f++){
+    for(g = 0 ; g < G_LIMIT ; g++){
+      open->bucket[f][g].count = 0 ;
+    }
+  }
+
+  open->min_f = F_LIMIT ;
+  open->max_f = -1 ;
+  open->count = 0 ;
+
+  return ;
+}
+
+/* Boards are owned (and freed) by the arena. */
+INTERNAL void free_open_list(Open_List *open)
+{
+  int f, g ;
+
+  for(f = 0 ; f < F_LIMIT ; f++){
+    for(g = 0 ; g < G_LIMIT ; g++){
+      free(open->bucket[f][g].board) ;
+    }
+  }
+
+  return ;
+}
@@ -0,0 +1,151 @@
+/*
+ * Header including the ranking functions for extension of
+ * 8-tile. Each board is a permutation of its n tiles, so
+ * its Lehmer code maps it to a unique integer in [0, n!).
+ * The rank is used as the key of each board and to index a
+ * visited bitmap. Only used for boards of up to RANK_CELLS
+ * cells, see manhattan_hash_operations.h for the others.
+ */
+#include <stdlib.h>
+
+/*
+ * Digit of each cell in the permutation is the code of its
+ * tile in the packed board, so the solution is the identity
+ * permutation and has rank 0.
+ */
+#define SOLUTION_RANK 0
+
+/* Mask of every digit lower than d. */
+#define LOWER_DIGITS(d) ((1U << d) - 1)
+
+/* 
+ * One bit per board, ie 9! / 8 = 45360 bytes for 3x3. The
+ * weight of each place, place_value, and the number of
+ * boards, NUM_BOARDS, are in manhattan_tables.h.
+ */
+#define VISITED_BYTES ((NUM_BOARDS / 8) + 1)
+#define IS_VISITED(v, r) (v[r >> 3] & (1 << (r & 7)))
+#define MARK_VISITED(v, r) (v[r >> 3] |= (1 << (r & 7)))
+
+/* Visited: one bit for each rank. */
+typedef unsigned char Visited ;
+
+INTERNAL Visited *create_visited(void) ;
+INTERNAL int was_visited(Visited *visited, Packed board) ;
+INTERNAL int mark_visited(Visited *visited, Packed board) ;
+INTERNAL void clear_visited(Visited *visited, Arena *arena) ;
+INTERNAL void free_visited(Visited *visited) ;
+INTERNAL unsigned long board_rank(Packed board) ;
+INTERNAL Packed rank_to_board(unsigned long rank) ;
+
+
+/* 
+ * Empty bitmap, ie no board has been visited as of yet, or
+ * NULL if there is no room for it.
+ */
+INTERNAL Visited *create_visited(void)
+{
+  return (Visited *)calloc(VISITED_BYTES, sizeof(Visited)) ;
+}
+
+INTERNAL int was_visited(Visited *visited, Packed board)
+{
+  unsigned long rank ;
+
+  rank = board_rank(board) ;
+
+  return IS_VISITED(visited, rank) ? 1 : 0 ;
+}
+
+/* Never fails, as the bitmap has a bit for every board. */
+INTERNAL int mark_visited(Visited *visited, Packed board)
+{
+  unsigned long rank ;
+
+  rank = board_rank(board) ;
+
+  MARK_VISITED(visited, rank) ;
+
+  return SOLVER_OK ;
+}
+
+/*
+ * Empties the bitmap, ready for another search. Only boards
+ * in the arena can have been marked, so only their bytes are
+ * cleared (any other bit in them is an arena board too),
+ * rather than the whole bitmap.
+ */
+INTERNAL void clear_visited(Visited *visited, Arena *arena)
+{
+  unsigned long rank ;
+  int i ;
+
+  for(i = 0 ; i < arena->count ; i++){
+    rank = board_rank(NODE(arena, i)->board) ;
+
+    visited[rank >> 3] = 0 ;
+  }
+
+  return ;
+}
+
+INTERNAL void free_visited(Visited *visited)
+{
+  free(visited) ;
+
+  return ;
+}
+
+/* Lehmer code of board, using a bitmask of used digits. */
+INTERNAL unsigned long board_rank(Packed board)
+{
+  unsigned long rank ;
+  unsigned int used, digit ;
+  int i ;
+
+  rank = 0 ;
+  used = 0 ;
+
+  /* Last place is always 0, so can be skipped. */
+  for(i = 0 ; i < NUM_WO_BLANK ; i++){
+    digit = CELL(board, i) ;
+
+    /* Number of smaller digits that are still unused. */
+    rank += (digit - __builtin_popcount(used & \
+    LOWER_DIGITS(digit))) * place_value[i] ;
+
+    used |= (1U << digit) ;
+  }
+
+  return rank ;
+}
+
+/* Inverse of board_rank - the board with the given rank. */
+INTERNAL Packed rank_to_board(unsigned long rank)
+{
+  unsigned int unused, digit, skip ;
+  Packed board ;
+  int i ;
+
+  unused = LOWER_DIGITS(NUM_TILES) ;
+  board = 0 ;
+
+  for(i = 0 ; i < NUM_TILES ; i++){
+    skip = rank / place_value[i] ;
+    rank %= place_value[i] ;
+
+    /* Find the unused digit with skip unused below it. */
+    for(digit = 0 ; (skip > 0) || !(unused & (1U << digit)) ; \
+    digit++){
+      if(unused & (1U << digit)){
+        skip-- ;
+      }
+    }
+
+    board |= (Packed)digit << (i * CELL_BITS) ;
+
+    unused &= ~(1U << digit) ;
+  }
+
+  return board ;
+}
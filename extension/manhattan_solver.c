@@ -0,0 +1,1847 @@
+/*
+ * The solver library of the extension of 8-tile (see
+ * manhattan_solver.h): every search, behind create_solver,
+ * solve_board, solve_list and solve. Nothing here prints or
+ * exits, each error is returned as a status, and everything
+ * a search keeps is in its Solver, so solvers in different
+ * threads never touch the same memory (but for the tables
+ * they map read only). The only statics are const tables.
+ */
+/* Needed for mmap() of the distance oracle. */
+#define _POSIX_C_SOURCE 200112L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <sched.h>
+#include "manhattan_solver.h"
+#include "manhattan_internal.h"
+#include "manhattan_arena_operations.h"
+#include "manhattan_tables.h"
+#include "manhattan_queue_operations.h"
+#include "manhattan_distance_operations.h"
+#include "manhattan_kernel_operations.h"
+#include "manhattan_pdb_operations.h"
+#include "manhattan_walking_operations.h"
+#include "manhattan_heuristic_operations.h"
+#include "manhattan_pool_operations.h"
+#include "manhattan_hda_operations.h"
+
+/* Small boards are ranked into a bitmap, others hashed. */
+#if (YS * XS) <= RANK_CELLS
+#include "manhattan_rank_operations.h"
+#else
+#include "manhattan_hash_operations.h"
+#endif
+
+/* The distance oracle only exists for 3x3 boards. */
+#if (YS == 3) && (XS == 3)
+#define ORACLE_BOARD
+#include "manhattan_oracle_operations.h"
+#endif
+
+/* Message of each status, see solver_message. */
+#define UNSOLVABLE_BOARD_ERROR "\nERROR: Unfortunately, " \
+"this board is unsolvable :(\nTry another!\n\n"
+#define BOARD_ERROR "\nERROR: Board does not have exactly " \
+"one of each tile and one blank.\n\n"
+#define GOAL_ERROR "\nERROR: Goal does not have exactly " \
+"one of each tile and one blank.\n\n"
+#define OPTIONS_ERROR "\nERROR: Options of the solver " \
+"cannot be used together, or for this board size.\n\n"
+#define MEMORY_ERROR "\nERROR: Unable to allocate space " \
+"for the search.\n\n"
+#define PATH_ERROR "\nERROR: Solution is longer than the " \
+"path given for it.\n\n"
+#define EMPTY_QUEUE_ERROR "\nERROR: Open list is empty but " \
+"the solution has not been found.\n\n"
+#define TABLES_ERROR "\nERROR: Generated tables do not " \
+"match the bounds checks and tile positions.\n\n"
+#define ORACLE_TABLE_ERROR "\nERROR: No move in the distance " \
+"table leads closer to the solution.\n\n"
+#define PDB_LOSSY_ERROR "\nERROR: A* needs pattern databases " \
+"that are exact, use -i or -p with compressed ones.\n\n"
+#define ORACLE_GOAL_ERROR "\nERROR: The distance oracle " \
+"only solves to a goal with the blank in the last cell.\n\n"
+#define HDA_THREAD_ERROR "\nERROR: Unable to start a " \
+"thread of the parallel search.\n\n"
+#define HDA_ARENA_ERROR "\nERROR: Too many boards for the " \
+"parallel search to record their parents.\n\n"
+#define IDA_DEPTH_ERROR "\nERROR: IDA* has gone deeper than " \
+"the longest solution it can record.\n\n"
+#define UNKNOWN_ERROR "\nERROR: Unknown status of the " \
+"solver.\n\n"
+
+/* Boards of a list scored by one call of the kernel. */
+#define SCORE_BOARDS 64
+
+/* Every heuristic that can be chosen. */
+#define ALL_HEURISTICS (MANHATTAN_HEURISTIC | \
+CONFLICT_HEURISTIC | INVERSION_HEURISTIC | PDB_HEURISTIC | \
+WALKING_HEURISTIC)
+
+/*
+ * Longest solution IDA* can record (3x3 boards need at most
+ * 31 moves and 4x4 at most 80), ie the deepest its
+ * recursion can go.
+ */
+#define IDA_DEPTH_LIMIT 128
+
+/* Returned by ida_search, once the solution is found. */
+#define IDA_FOUND -1
+
+/* Returned by ida_search, once past IDA_DEPTH_LIMIT. */
+#define IDA_TOO_DEEP -2
+
+/* Smallest f over the bound when no board was over it. */
+#define IDA_NO_BOUND INT_MAX
+
+/* Incumbent of the parallel A* until a solution is found. */
+#define HDA_NO_SOLUTION INT_MAX
+
+/* Boards expanded by a thread between sending its outboxes.*/
+#define HDA_FLUSH 64
+
+#define TRUE 1
+#define FALSE 0
+
+/* Defines starting position (ie, original board in file).*/
+#define ROOT_NODE -1
+
+/* Starting board was not made by a move, so none to undo. */
+#define NO_MOVE -1
+
+/* Every count in the search starts at zero. */
+#define NULL_STATS {0, 0, 0}
+
+/* Four Possible move/swap directions - ie, N, E, S and W.*/
+#define MOVE_DIRECTIONS 4
+
+/* Most children a board can have, ie blank in centre. */
+#define MAX_CHILDREN MOVE_DIRECTIONS
+/*
+ * Bounds check used when determining if the blank tile
+ * could possibly be N, E, S or W, respectively, from the
+ * current tile, t (our position in 2D array from [0][0]).
+ * NB: Only used to check the tables in manhattan_tables.h,
+ * which are used instead when searching.
+ */
+#define NORTH_POSSIBLE(t) (t > XS - 1)
+#define EAST_POSSIBLE(t) (((t + 1) % XS) != 0)
+#define SOUTH_POSSIBLE(t) (t < ((YS * XS) - XS))
+#define WEST_POSSIBLE(t) (((t + XS) % XS) != 0)
+
+/* Values needed to move N, E, S and W using pnter arthm. */
+#define MOVE_N -XS
+#define MOVE_E 1
+#define MOVE_S XS
+#define MOVE_W -1
+
+/* Used to define relavant direction from centre tile. */
+#define N north
+#define E east
+#define S south
+#define W west
+
+enum compass {north, east, south, west} ;
+typedef enum compass compass ;
+
+/* List_Start: a board of a list, packed and scored. */
+struct list_start{
+  Packed packed ;
+  int blank ;
+  int distance ;
+} ;
+typedef struct list_start List_Start ;
+
+/* List_State: each thread's solver and the boards given. */
+struct list_state{
+  Solver *solver ;
+  Solver_Board *boards ;
+  List_Start *start ;
+} ;
+typedef struct list_state List_State ;
+
+/*
+ * Solver: everything kept between boards, made only once.
+ * For a list, each thread has its own (workers, made on the
+ * first list), which share this one's tables. The parallel
+ * A* has its own threads, each with an arena.
+ */
+struct solver{
+  Arena arena ;
+  Open_List open ;
+  Visited *visited ;
+  Hda hda ;
+  unsigned char *oracle ;
+  int shared ;
+  Goal goal ;
+  Solver_Engine search ;
+  Heuristic heuristic ;
+  int threads ;
+  List_State *state ;
+  void **state_list ;
+  int workers ;
+  Pool pool ;
+} ;
+
+static int load_tables(Solver *solver, \
+const Solver_Options *options, const char **failed) ;
+static char *message_format(int status) ;
+static int run_search(Solver *solver, Packed board, int blank, \
+int distance, Solver_Result *result) ;
+static int search_board(Solver *solver, Search_Stats *stats, \
+int *solution) ;
+static int trace_path(Solver *solver, int solution, \
+Solver_Result *result) ;
+static void reset_solver(Solver *solver) ;
+static int copy_solver(Solver *copy, Solver *solver) ;
+static int create_workers(Solver *solver, int threads) ;
+static void free_workers(Solver *solver) ;
+static void score_list(Solver_Board *boards, \
+List_Start *start, int count, Goal *goal) ;
+static void solve_item(void *state, int item) ;
+static int start_board(Arena *arena, Packed board, int blank, \
+int distance, Heuristic *heuristic) ;
+static int allocate_space(Arena *arena, Puzzle *board) ;
+static int find_optimal_solution(Arena *arena, \
+Open_List *open, Visited *visited, Heuristic *heuristic, \
+Search_Stats *stats, int *solution) ;
+static int check_if_solution(Puzzle *current) ;
+static int define_options_and_explore(Arena *arena, \
+int counter, Open_List *open, Visited *visited, \
+Heuristic *heuristic, Search_Stats *stats) ;
+#ifdef MANHATTAN_DEBUG
+static void determine_search_directions(int tile, \
+int *direction) ;
+static int check_tables(void) ;
+static int check_children(Puzzle *children, int num_children, \
+Heuristic *heuristic) ;
+#endif
+static int generate_children(Puzzle *current, int counter, \
+Puzzle *children, Heuristic *heuristic, Search_Stats *stats) ;
+static int create_next_board(Puzzle *child, Arena *arena, \
+Open_List *open, Visited *visited) ;
+static void make_move(Puzzle *current, Puzzle *child, \
+int counter, int tile, Heuristic *heuristic) ;
+#ifdef ORACLE_BOARD
+static int follow_oracle(Arena *arena, unsigned char *oracle, \
+Heuristic *heuristic, Search_Stats *stats, int *solution) ;
+#endif
+static int hda_star(Hda *hda, Arena *arena, \
+Heuristic *heuristic, Search_Stats *stats, int *solution) ;
+static void *hda_worker(void *arg) ;
+static int hda_idle(Hda_Thread *thread) ;
+static void hda_receive(Hda_Thread *thread) ;
+static void hda_add_board(Hda_Thread *thread, Puzzle *board) ;
+static void hda_expand(Hda_Thread *thread, int counter) ;
+static void hda_send(Hda_Thread *thread, int owner, \
+Puzzle *child) ;
+static void hda_post(Hda_Thread *thread, int owner) ;
+static void hda_flush(Hda_Thread *thread) ;
+static void hda_goal(Hda_Thread *thread, int counter) ;
+static int hda_path(Hda *hda, Arena *arena, int *solution) ;
+static int ida_star(Arena *arena, Heuristic *heuristic, \
+Search_Stats *stats, int *solution) ;
+static int ida_search(Puzzle *board, int bound, int *path, \
+Heuristic *heuristic, Search_Stats *stats) ;
+
+
+/*
+ * Makes everything the search needs, once, so that it can
+ * be reused (warm) for every board. Solver is NULL unless
+ * the status is SOLVER_OK. Failed (if not NULL) is the name
+ * of a file that cannot be used, else NULL.
+ */
+int create_solver(Solver **solver, const Solver_Options *options, \
+const char **failed)
+{
+  Solver *s ;
+  const char *file ;
+  int status ;
+
+  *solver = NULL ;
+
+  /* Set before any return, so never left for the caller. */
+  if(failed != NULL){
+    *failed = NULL ;
+  }
+
+#ifdef MANHATTAN_DEBUG
+  if((status = check_tables()) != SOLVER_OK){
+    return status ;
+  }
+#endif
+
+  if((options->threads < 1) || ((int)options->search < \
+  (int)A_STAR) || ((int)options->search > (int)HDA_STAR) || \
+  (options->heuristic & ~ALL_HEURISTICS) || \
+  ((options->heuristic & PDB_HEURISTIC) && \
+  (options->pdb_files == NULL))){
+    return SOLVER_OPTIONS_ERROR ;
+  }
+
+#ifndef ORACLE_BOARD
+  if(options->search == ORACLE){
+    return SOLVER_OPTIONS_ERROR ;
+  }
+#endif
+
+  if((options->goal != NULL) && !valid_board(options->goal)){
+    return SOLVER_GOAL_ERROR ;
+  }
+
+  /* Zeroed, so whatever was made can be freed on an error. */
+  if((s = (Solver *)calloc(1, sizeof(Solver))) == NULL){
+    return SOLVER_MEMORY_ERROR ;
+  }
+
+  s->search = options->search ;
+  s->heuristic.chosen = options->heuristic ;
+  s->threads = options->threads ;
+
+  /* Tiles are relabelled to suit the goal, see its header. */
+  if(options->goal == NULL){
+    usual_goal(&s->goal) ;
+  }
+
+  else{
+    make_goal(options->goal, &s->goal) ;
+  }
+
+  create_open_list(&s->open) ;
+
+  status = (s->search == HDA_STAR) ? create_hda(&s->hda, \
+  s->threads) : SOLVER_OK ;
+
+  if(status == SOLVER_OK){
+    status = create_arena(&s->arena) ;
+  }
+
+  if((status == SOLVER_OK) && \
+  ((s->visited = create_visited()) == NULL)){
+    status = SOLVER_MEMORY_ERROR ;
+  }
+
+  if(status == SOLVER_OK){
+    file = NULL ;
+    status = load_tables(s, options, &file) ;
+
+    if(failed != NULL){
+      *failed = file ;
+    }
+  }
+
+  if(status != SOLVER_OK){
+    free_solver(s) ;
+    return status ;
+  }
+
+  *solver = s ;
+
+  return SOLVER_OK ;
+}
+
+/*
+ * Tables added to the heuristics, once the goal is known, or
+ * the oracle. The name of a file that cannot be used is
+ * left in failed.
+ */
+static int load_tables(Solver *solver, \
+const Solver_Options *options, const char **failed)
+{
+  int status ;
+#ifdef ORACLE_BOARD
+  const char *file ;
+#endif
+
+  if(options->pdb_files != NULL){
+    status = load_pdbs(options->pdb_files, solver->goal.blank, \
+    &solver->heuristic.pdb, failed) ;
+
+    if(status != SOLVER_OK){
+      return status ;
+    }
+
+    solver->heuristic.chosen |= PDB_HEURISTIC ;
+
+    /* A* expands a board once, so needs every move exact. */
+    if((solver->search == A_STAR) && \
+    !solver->heuristic.pdb->exact){
+      return SOLVER_PDB_LOSSY_ERROR ;
+    }
+  }
+
+  /* Walking distance is to this goal's blank. */
+  if((solver->heuristic.chosen & WALKING_HEURISTIC) && \
+  ((status = create_walking(&solver->heuristic.walking, \
+  solver->goal.blank)) != SOLVER_OK)){
+    return status ;
+  }
+
+#ifdef ORACLE_BOARD
+  if(solver->search == ORACLE){
+    /* The oracle holds moves to the goal with blank last. */
+    if(solver->goal.blank != NUM_WO_BLANK){
+      return SOLVER_ORACLE_GOAL_ERROR ;
+    }
+
+    file = (options->oracle_file != NULL) ? \
+    options->oracle_file : ORACLE_FILE ;
+
+    if((status = load_oracle(file, &solver->oracle)) != \
+    SOLVER_OK){
+      *failed = file ;
+      return status ;
+    }
+  }
+#endif
+
+  return SOLVER_OK ;
+}
+
+/*
+ * Solves board (NUM_TILES chars, blank as ' ') to the goal.
+ * The solver is left empty, ready for the next board, even
+ * if the search failed.
+ */
+int solve_board(Solver *solver, char *board, \
+Solver_Result *result)
+{
+  Packed packed ;
+  int blank ;
+
+  result->moves = 0 ;
+
+  if(!valid_board(board)){
+    return SOLVER_BOARD_ERROR ;
+  }
+
+  /* Check is solvable at the start - extension work. */
+  if(!solvable_board(board, solver->goal.tile)){
+    return SOLVER_UNSOLVABLE ;
+  }
+
+  /* From here on, the solver only uses the packed board. */
+  packed = pack_board(board, &solver->goal) ;
+
+  for(blank = 0 ; board[blank] != BLANK ; blank++) ;
+
+  return run_search(solver, packed, blank, \
+  manhattan_function(packed, blank, 0), result) ;
+}
+
+/*
+ * Makes a solver, solves the one board, then frees it. A file
+ * that cannot be used is named in the result (failed).
+ */
+int solve(char *board, const Solver_Options *options, \
+Solver_Result *result)
+{
+  Solver *solver ;
+  int status ;
+
+  if((status = create_solver(&solver, options, \
+  &result->failed)) != SOLVER_OK){
+    return status ;
+  }
+
+  status = solve_board(solver, board, result) ;
+
+  free_solver(solver) ;
+
+  return status ;
+}
+
+/* Searches from the packed board, given its distance. */
+static int run_search(Solver *solver, Packed board, int blank, \
+int distance, Solver_Result *result)
+{
+  Search_Stats null_stats = NULL_STATS ;
+  int status, solution ;
+
+  result->stats = null_stats ;
+  result->moves = 0 ;
+
+  status = start_board(&solver->arena, board, blank, distance, \
+  &solver->heuristic) ;
+
+  if(status == SOLVER_OK){
+    status = search_board(solver, &result->stats, &solution) ;
+  }
+
+  if(status == SOLVER_OK){
+    result->moves = NODE(&solver->arena, solution)->moves ;
+
+    status = trace_path(solver, solution, result) ;
+  }
+
+  reset_solver(solver) ;
+
+  return status ;
+}
+
+/* Solves the first board in the arena, gives the solution. */
+static int search_board(Solver *solver, Search_Stats *stats, \
+int *solution)
+{
+  int status ;
+
+  switch(solver->search){
+  case A_STAR :
+    /* Starting board is the first board in the arena. */
+    status = push_board(&solver->open, 0, \
+    NODE(&solver->arena, 0)->manhattan, 0) ;
+
+    if(status == SOLVER_OK){
+      status = find_optimal_solution(&solver->arena, \
+      &solver->open, solver->visited, &solver->heuristic, \
+      stats, solution) ;
+    }
+    break ;
+
+  /* IDA* keeps only the current board, so uses no arena. */
+  case IDA_STAR :
+    status = ida_star(&solver->arena, &solver->heuristic, \
+    stats, solution) ;
+    break ;
+
+  case HDA_STAR :
+    status = hda_star(&solver->hda, &solver->arena, \
+    &solver->heuristic, stats, solution) ;
+    break ;
+
+#ifdef ORACLE_BOARD
+  /* Distance oracle (table file) given before the board. */
+  case ORACLE :
+    status = follow_oracle(&solver->arena, solver->oracle, \
+    &solver->heuristic, stats, solution) ;
+    break ;
+#endif
+
+  default :
+    status = SOLVER_OPTIONS_ERROR ;
+    break ;
+  }
+
+  return status ;
+}
+
+/*
+ * Unpacks each board of the solution, by tracing back from
+ * it, into the caller's path (if any), from the start.
+ */
+static int trace_path(Solver *solver, int solution, \
+Solver_Result *result)
+{
+  int i, place ;
+
+  if(result->path == NULL){
+    return SOLVER_OK ;
+  }
+
+  if(result->moves >= result->path_size){
+    return SOLVER_PATH_ERROR ;
+  }
+
+  place = solution ;
+
+  for(i = result->moves ; i >= 0 ; i--){
+    unpack_board(NODE(&solver->arena, place)->board, \
+    result->path + (i * NUM_TILES), &solver->goal) ;
+
+    place = NODE(&solver->arena, place)->parent ;
+  }
+
+  return SOLVER_OK ;
+}
+
+/*
+ * Empties the solver, ready for the next board. Only what
+ * the last search used is cleared, nothing is freed.
+ */
+static void reset_solver(Solver *solver)
+{
+  clear_visited(solver->visited, &solver->arena) ;
+
+  reset_open_list(&solver->open) ;
+
+  reset_arena(&solver->arena) ;
+
+  if(solver->search == HDA_STAR){
+    reset_hda(&solver->hda) ;
+  }
+
+  return ;
+}
+
+/*
+ * Another solver (for a thread), sharing the oracle, the
+ * pattern databases and the walking distance tables.
+ */
+static int copy_solver(Solver *copy, Solver *solver)
+{
+  int status ;
+
+  copy->search = solver->search ;
+  copy->heuristic = solver->heuristic ;
+  copy->goal = solver->goal ;
+  copy->oracle = solver->oracle ;
+  copy->threads = solver->threads ;
+  copy->shared = TRUE ;
+
+  create_open_list(&copy->open) ;
+
+  if((solver->search == HDA_STAR) && ((status = \
+  create_hda(&copy->hda, solver->hda.threads)) != SOLVER_OK)){
+    return status ;
+  }
+
+  if((status = create_arena(&copy->arena)) != SOLVER_OK){
+    return status ;
+  }
+
+  if((copy->visited = create_visited()) == NULL){
+    return SOLVER_MEMORY_ERROR ;
+  }
+
+  return SOLVER_OK ;
+}
+
+void free_solver(Solver *solver)
+{
+  if(solver == NULL){
+    return ;
+  }
+
+  free_workers(solver) ;
+
+#ifdef ORACLE_BOARD
+  if((solver->oracle != NULL) && !solver->shared){
+    free_oracle(solver->oracle) ;
+  }
+#endif
+
+  if((solver->heuristic.pdb != NULL) && !solver->shared){
+    free_pdbs(solver->heuristic.pdb) ;
+  }
+
+  if((solver->heuristic.walking != NULL) && !solver->shared){
+    free_walking(solver->heuristic.walking) ;
+  }
+
+  if(solver->visited != NULL){
+    free_visited(solver->visited) ;
+  }
+
+  free_open_list(&solver->open) ;
+
+  free_arena(&solver->arena) ;
+
+  if(solver->search == HDA_STAR){
+    free_hda(&solver->hda) ;
+  }
+
+  free(solver) ;
+
+  return ;
+}
+
+/*
+ * Solves every board of the list, each with its own status,
+ * moves and stats (boards that are not SOLVER_OK are left).
+ * Boards are solved in parallel by the pool, each thread
+ * with its own solver, which is kept for the next list. The
+ * parallel A* uses the threads, so boards are one by one.
+ */
+int solve_list(Solver *solver, Solver_Board *boards, \
+int count)
+{
+  List_Start *start ;
+  int i, status, threads ;
+
+  if(count < 1){
+    return SOLVER_OK ;
+  }
+
+  threads = (solver->search == HDA_STAR) ? 1 : solver->threads ;
+
+  if((solver->workers == 0) && \
+  ((status = create_workers(solver, threads)) != SOLVER_OK)){
+    return status ;
+  }
+
+  start = (List_Start *)malloc(count * sizeof(List_Start)) ;
+
+  if(start == NULL){
+    return SOLVER_MEMORY_ERROR ;
+  }
+
+  score_list(boards, start, count, &solver->goal) ;
+
+  for(i = 0 ; i < solver->workers ; i++){
+    solver->state[i].boards = boards ;
+    solver->state[i].start = start ;
+  }
+
+  status = run_pool(&solver->pool, count) ;
+
+  free(start) ;
+
+  return status ;
+}
+
+/* First thread uses the solver itself, others a copy. */
+static int create_workers(Solver *solver, int threads)
+{
+  Solver *copy ;
+  int i, status ;
+
+  solver->state = (List_State *)malloc(threads * \
+  sizeof(List_State)) ;
+
+  solver->state_list = (void **)malloc(threads * \
+  sizeof(void *)) ;
+
+  status = ((solver->state == NULL) || \
+  (solver->state_list == NULL)) ? SOLVER_MEMORY_ERROR : \
+  SOLVER_OK ;
+
+  for(i = 0 ; (status == SOLVER_OK) && (i < threads) ; i++){
+    copy = (i == 0) ? solver : (Solver *)calloc(1, \
+    sizeof(Solver)) ;
+
+    if(copy == NULL){
+      status = SOLVER_MEMORY_ERROR ;
+    }
+
+    else{
+      if(i > 0){
+        status = copy_solver(copy, solver) ;
+      }
+
+      solver->state[i].solver = copy ;
+      solver->state_list[i] = &solver->state[i] ;
+      solver->workers++ ;
+    }
+  }
+
+  if(status == SOLVER_OK){
+    status = create_pool(&solver->pool, threads, \
+    solver->state_list, solve_item) ;
+  }
+
+  if(status != SOLVER_OK){
+    free_workers(solver) ;
+  }
+
+  return status ;
+}
+
+static void free_workers(Solver *solver)
+{
+  int i ;
+
+  for(i = 1 ; i < solver->workers ; i++){
+    free_solver(solver->state[i].solver) ;
+  }
+
+  if(solver->pool.deque != NULL){
+    free_pool(&solver->pool) ;
+    solver->pool.deque = NULL ;
+  }
+
+  free(solver->state_list) ;
+  free(solver->state) ;
+
+  solver->state_list = NULL ;
+  solver->state = NULL ;
+  solver->workers = 0 ;
+
+  return ;
+}
+
+/*
+ * Packs every valid board of the list, then works out their
+ * distances in bulk, SCORE_BOARDS at a time (see the kernel).
+ */
+static void score_list(Solver_Board *boards, \
+List_Start *start, int count, Goal *goal)
+{
+  Packed board[SCORE_BOARDS] ;
+  int blank[SCORE_BOARDS], distance[SCORE_BOARDS] ;
+  int place[SCORE_BOARDS] ;
+  int i, j, scored ;
+
+  scored = 0 ;
+
+  for(i = 0 ; i < count ; i++){
+    if((boards[i].status == SOLVER_OK) && \
+    !valid_board(boards[i].board)){
+      boards[i].status = SOLVER_BOARD_ERROR ;
+    }
+
+    if(boards[i].status == SOLVER_OK){
+      start[i].packed = pack_board(boards[i].board, goal) ;
+
+      for(start[i].blank = 0 ; \
+      boards[i].board[start[i].blank] != BLANK ; \
+      start[i].blank++) ;
+
+      board[scored] = start[i].packed ;
+      blank[scored] = start[i].blank ;
+      place[scored++] = i ;
+    }
+
+    if((scored == SCORE_BOARDS) || \
+    ((i == count - 1) && (scored > 0))){
+      score_boards(board, blank, distance, scored) ;
+
+      for(j = 0 ; j < scored ; j++){
+        start[place[j]].distance = distance[j] ;
+      }
+
+      scored = 0 ;
+    }
+  }
+
+  return ;
+}
+
+/* Pool task: solves one board with the thread's solver. */
+static void solve_item(void *state, int item)
+{
+  Solver *solver ;
+  Solver_Board *b ;
+  List_Start *start ;
+  Solver_Result result = SOLVER_NO_PATH ;
+
+  solver = ((List_State *)state)->solver ;
+  b = &((List_State *)state)->boards[item] ;
+  start = &((List_State *)state)->start[item] ;
+
+  if(b->status != SOLVER_OK){
+    return ;
+  }
+
+  if(!solvable_board(b->board, solver->goal.tile)){
+    b->status = SOLVER_UNSOLVABLE ;
+    return ;
+  }
+
+  /* Starting board was packed and scored with the list. */
+  b->status = run_search(solver, start->packed, start->blank, \
+  start->distance, &result) ;
+
+  b->moves = result.moves ;
+  b->stats = result.stats ;
+
+  return ;
+}
+
+/*
+ * Adds the starting board (first in the arena), given its
+ * distance, with whatever else the heuristics need of it.
+ */
+static int start_board(Arena *arena, Packed board, int blank, \
+int distance, Heuristic *heuristic)
+{
+  Puzzle root ;
+
+  root.board = board ;
+  root.blank = blank ;
+  root.last_blank = NO_MOVE ;
+
+  /* Starting board is root and no moves made as of yet.*/
+  root.parent = ROOT_NODE ;
+  root.moves = 0 ;
+
+  /* Distance is carried, so children need only update it. */
+  root.distance = distance ;
+
+  score_estimate(&root, heuristic) ;
+
+  return (allocate_space(arena, &root) == ARENA_FULL) ? \
+  SOLVER_MEMORY_ERROR : SOLVER_OK ;
+}
+
+/*
+ * Adds a copy of board to the back of the arena, returns its
+ * place, or ARENA_FULL.
+ */
+static int allocate_space(Arena *arena, Puzzle *board)
+{
+  int place ;
+
+  if((place = new_board(arena)) != ARENA_FULL){
+    *NODE(arena, place) = *board ;
+  }
+
+  return place ;
+}
+
+/* Finds the optimum solution, gives its place in arena. */
+static int find_optimal_solution(Arena *arena, \
+Open_List *open, Visited *visited, Heuristic *heuristic, \
+Search_Stats *stats, int *solution)
+{
+  Puzzle *current ;
+  int counter, status ;
+
+  counter = pop_board(open) ;
+  current = NODE(arena, counter) ;
+
+  /*
+   * While current board in the queue is not the solution,
+   * we add any 'child' boards the queue base on priority.
+   */
+  while(!check_if_solution(current)){
+    /*
+     * A board can be queued more than once, but only the
+     * first copy popped (lowest f) is expanded. Visited
+     * therefore holds the boards that have been expanded.
+     */
+    if(!was_visited(visited, current->board)){
+      if(((status = mark_visited(visited, current->board)) != \
+      SOLVER_OK) || ((status = define_options_and_explore( \
+      arena, counter, open, visited, heuristic, stats)) != \
+      SOLVER_OK)){
+        return status ;
+      }
+    }
+
+    if((counter = pop_board(open)) == EMPTY_QUEUE){
+      return SOLVER_QUEUE_ERROR ;
+    }
+
+    current = NODE(arena, counter) ;
+  }
+
+  *solution = counter ;
+
+  return SOLVER_OK ;
+}
+
+/* Checks if board is the solution, ie a single compare. */
+static int check_if_solution(Puzzle *current)
+{
+  if(current->board == PACKED_SOLUTION){
+    return TRUE ;
+  }
+
+  return FALSE ;
+}
+
+/* Creates each child of the board, then queues each one. */
+static int define_options_and_explore(Arena *arena, \
+int counter, Open_List *open, Visited *visited, \
+Heuristic *heuristic, Search_Stats *stats)
+{
+  /* Filled with children on the stack, so no allocation. */
+  Puzzle children[MAX_CHILDREN] ;
+  int i, num_children, status ;
+
+  stats->expanded++ ;
+
+  num_children = generate_children(NODE(arena, counter), \
+  counter, children, heuristic, stats) ;
+
+#ifdef MANHATTAN_DEBUG
+  if((status = check_children(children, num_children, \
+  heuristic)) != SOLVER_OK){
+    return status ;
+  }
+#endif
+
+  for(i = 0 ; i < num_children ; i++){
+    if((status = create_next_board(&children[i], arena, open, \
+    visited)) != SOLVER_OK){
+      return status ;
+    }
+  }
+
+  return SOLVER_OK ;
+}
+
+/*
+ * Only tiles next to the blank can move (see tables), so
+ * fills children with the legal children of current and
+ * returns how many there are (1 to MAX_CHILDREN). The move
+ * that made current acts as the state of a simple automaton
+ * that never allows its inverse, as sliding the tile back
+ * into last_blank would only recreate the parent.
+ */
+static int generate_children(Puzzle *current, int counter, \
+Puzzle *children, Heuristic *heuristic, Search_Stats *stats)
+{
+  int i, tile, blank, num_children ;
+
+  blank = current->blank ;
+  num_children = 0 ;
+
+  for(i = 0 ; i < neighbour_count[blank] ; i++){
+    tile = neighbour[blank][i] ;
+
+    if(tile == current->last_blank){
+      stats->pruned++ ;
+    }
+
+    else{
+      make_move(current, &children[num_children++], counter, \
+      tile, heuristic) ;
+    }
+  }
+
+  stats->generated += num_children ;
+
+  return num_children ;
+}
+
+#ifdef MANHATTAN_DEBUG
+/* Bounds checks - is possible to search N, E, S, W. */
+static void determine_search_directions(int tile, \
+int *direction)
+{
+  /*
+   * If search direction possible, the amount needed to be
+   * added to reach the cell from current position/pointer
+   * is entered into corresponding cell of options array.
+   */
+  NORTH_POSSIBLE(tile) ? (*(direction + N) = MOVE_N) : \
+  (*(direction + N) = FALSE) ;
+
+  EAST_POSSIBLE(tile) ? (*(direction + E) = MOVE_E) : \
+  (*(direction + E) = FALSE) ;
+
+  SOUTH_POSSIBLE(tile) ? (*(direction + S) = MOVE_S) : \
+  (*(direction + S) = FALSE) ;
+
+  WEST_POSSIBLE(tile) ? (*(direction + W) = MOVE_W) : \
+  (*(direction + W) = FALSE) ;
+
+  return ;
+}
+
+/*
+ * Debug only - checks that the generated tables match the
+ * bounds checks and the cell each code belongs in exactly.
+ */
+static int check_tables(void)
+{
+  int blank, tile, code, cell, i, found ;
+  int search_direction[MOVE_DIRECTIONS], correct_y, correct_x ;
+
+  /* Tiles next to each blank cell, in ascending order. */
+  for(blank = 0 ; blank < NUM_TILES ; blank++){
+    found = 0 ;
+
+    for(tile = 0 ; tile < NUM_TILES ; tile++){
+      if(tile != blank){
+        determine_search_directions(tile, search_direction) ;
+
+        for(i = 0 ; i < MOVE_DIRECTIONS ; i++){
+          if(tile + search_direction[i] == blank){
+            if((found >= neighbour_count[blank]) || \
+            (neighbour[blank][found] != tile)){
+              return SOLVER_TABLES_ERROR ;
+            }
+
+            found++ ;
+          }
+        }
+      }
+    }
+
+    if(found != neighbour_count[blank]){
+      return SOLVER_TABLES_ERROR ;
+    }
+  }
+
+  /*
+   * Correct position and distance of every code, as any
+   * code is a tile for some goal. Code i belongs in cell i.
+   */
+  for(code = 0 ; code < NUM_TILES ; code++){
+    correct_y = code / XS ;
+    correct_x = code % XS ;
+
+    if((goal_y[code] != correct_y) || \
+    (goal_x[code] != correct_x)){
+      return SOLVER_TABLES_ERROR ;
+    }
+
+    for(cell = 0 ; cell < NUM_TILES ; cell++){
+      if(distance_table[code][cell] != \
+      abs(correct_y - (cell / XS)) + \
+      abs(correct_x - (cell % XS))){
+        return SOLVER_TABLES_ERROR ;
+      }
+    }
+  }
+
+  return SOLVER_OK ;
+}
+
+/*
+ * Debug only - catches any drift of the incremental distance
+ * of the children, against a full count of all of them at
+ * once (see the kernel), and of the rest of their estimate.
+ */
+static int check_children(Puzzle *children, int num_children, \
+Heuristic *heuristic)
+{
+  Packed board[MAX_CHILDREN] ;
+  int i, blank[MAX_CHILDREN], distance[MAX_CHILDREN] ;
+
+  for(i = 0 ; i < num_children ; i++){
+    board[i] = children[i].board ;
+    blank[i] = children[i].blank ;
+  }
+
+  score_boards(board, blank, distance, num_children) ;
+
+  for(i = 0 ; i < num_children ; i++){
+    if(distance[i] != children[i].distance){
+      return SOLVER_CHECK_ERROR ;
+    }
+
+    if(check_estimate(&children[i], heuristic) != SOLVER_OK){
+      return SOLVER_ESTIMATE_ERROR ;
+    }
+  }
+
+  return SOLVER_OK ;
+}
+#endif
+
+/* Adds next board to the open list, unless expanded. */
+static int create_next_board(Puzzle *child, Arena *arena, \
+Open_List *open, Visited *visited)
+{
+  int place ;
+
+  /* No need to queue a board that has been expanded. */
+  if(was_visited(visited, child->board)){
+    return SOLVER_OK ;
+  }
+
+  /* Add to back of the arena, which owns all boards. */
+  if((place = allocate_space(arena, child)) == ARENA_FULL){
+    return SOLVER_MEMORY_ERROR ;
+  }
+
+  /* Priority of the new board decides when it is used. */
+  return push_board(open, place, child->manhattan, \
+  child->moves) ;
+}
+
+/* Child is current with tile swapped with the blank tile. */
+static void make_move(Puzzle *current, Puzzle *child, \
+int counter, int tile, Heuristic *heuristic)
+{
+  int code ;
+
+  code = CELL(current->board, tile) ;
+
+  /* Only the tile that slides changes distance, by +/-1. */
+  child->distance = current->distance + \
+  distance_table[code][current->blank] - \
+  distance_table[code][tile] ;
+
+  /* Swap blank (in N, E, S, or W cell) with number tile. */
+  child->board = slide_tile(current->board, tile, \
+  current->blank) ;
+
+  /* Tile has moved, so blank is now where tile was. */
+  child->blank = tile ;
+
+  /* Remember the move, so that it is not undone. */
+  child->last_blank = current->blank ;
+
+  /* Moves to reach new board is one more than parent. */
+  child->moves = current->moves + 1 ;
+
+  /* Anything else the heuristics need is updated as well. */
+  update_estimate(current, child, tile, heuristic) ;
+
+  child->manhattan = child->moves + estimate(child, heuristic) ;
+
+  child->parent = counter ;
+
+  return ;
+}
+
+#ifdef ORACLE_BOARD
+/*
+ * Solves without searching: each step moves to the child
+ * that the distance oracle says is one move closer, so only
+ * the boards on the solution path are ever created.
+ */
+static int follow_oracle(Arena *arena, unsigned char *oracle, \
+Heuristic *heuristic, Search_Stats *stats, int *solution)
+{
+  Puzzle *current, children[MAX_CHILDREN] ;
+  int i, counter, closer, num_children ;
+
+  counter = 0 ;
+  current = NODE(arena, counter) ;
+
+  while(!check_if_solution(current)){
+    stats->expanded++ ;
+
+    num_children = generate_children(current, counter, \
+    children, heuristic, stats) ;
+
+    /* Distances are stored mod 16, so wrap round from 0. */
+    closer = (oracle_distance(oracle, current->board, \
+    current->blank) - 1) & ORACLE_MASK ;
+
+    for(i = 0 ; (i < num_children) && \
+    (oracle_distance(oracle, children[i].board, \
+    children[i].blank) != closer) ; i++) ;
+
+    /* Only happens if the table is not the distance oracle. */
+    if(i == num_children){
+      return SOLVER_ORACLE_TABLE_ERROR ;
+    }
+
+    if((counter = allocate_space(arena, &children[i])) == \
+    ARENA_FULL){
+      return SOLVER_MEMORY_ERROR ;
+    }
+
+    current = NODE(arena, counter) ;
+  }
+
+  *solution = counter ;
+
+  return SOLVER_OK ;
+}
+#endif
+
+/*
+ * Parallel A* (HDA*): each board is owned by the thread its
+ * hash picks, which alone queues and expands it, so no lock
+ * is needed for any open list or table. Children owned by
+ * another thread are sent to it (see the header). The first
+ * solution found may not be the best, so the search only
+ * ends once no thread has a board with f below the best
+ * solution (incumbent) and no message is left unread. The
+ * solution path is then added to the arena, as for IDA*.
+ * The first error of any thread ends the search for all.
+ */
+static int hda_star(Hda *hda, Arena *arena, \
+Heuristic *heuristic, Search_Stats *stats, int *solution)
+{
+  pthread_t *thread ;
+  Puzzle root ;
+  int i, started ;
+
+  thread = (pthread_t *)malloc(hda->threads * \
+  sizeof(pthread_t)) ;
+
+  if(thread == NULL){
+    return SOLVER_MEMORY_ERROR ;
+  }
+
+  hda->incumbent = HDA_NO_SOLUTION ;
+  hda->heuristic = heuristic ;
+  hda->status = SOLVER_OK ;
+
+  /* Every thread starts out searching. */
+  hda->work = hda->threads ;
+
+  /* Starting board is the first board in the arena. */
+  root = *NODE(arena, 0) ;
+
+  hda_add_board(&hda->thread[HDA_OWNER(root.board, \
+  hda->threads)], &root) ;
+
+  for(started = 1 ; started < hda->threads ; started++){
+    if(pthread_create(&thread[started], NULL, hda_worker, \
+    &hda->thread[started]) != 0){
+      hda_fail(hda, SOLVER_THREAD_ERROR) ;
+      break ;
+    }
+  }
+
+  /* Calling thread searches as thread 0. */
+  hda_worker(&hda->thread[0]) ;
+
+  for(i = 1 ; i < started ; i++){
+    pthread_join(thread[i], NULL) ;
+  }
+
+  free(thread) ;
+
+  if(hda->status != SOLVER_OK){
+    return hda->status ;
+  }
+
+  if(hda->incumbent == HDA_NO_SOLUTION){
+    return SOLVER_QUEUE_ERROR ;
+  }
+
+  for(i = 0 ; i < hda->threads ; i++){
+    stats->expanded += hda->thread[i].stats.expanded ;
+    stats->generated += hda->thread[i].stats.generated ;
+    stats->pruned += hda->thread[i].stats.pruned ;
+
+    hda->thread[i].stats.expanded = 0 ;
+    hda->thread[i].stats.generated = 0 ;
+    hda->thread[i].stats.pruned = 0 ;
+  }
+
+  return hda_path(hda, arena, solution) ;
+}
+
+/*
+ * Searches as one thread, until the whole search has ended,
+ * or any thread has failed.
+ */
+static void *hda_worker(void *arg)
+{
+  Hda_Thread *thread ;
+  Puzzle *current ;
+  int counter, expanded ;
+
+  thread = (Hda_Thread *)arg ;
+  expanded = 0 ;
+
+  while(__atomic_load_n(&thread->hda->status, \
+  __ATOMIC_ACQUIRE) == SOLVER_OK){
+    if(!mailbox_empty(&thread->mailbox)){
+      hda_receive(thread) ;
+    }
+
+    /*
+     * A board with f no lower than the incumbent can never
+     * lead to a better solution (the incumbent only falls),
+     * so is dropped.
+     */
+    while(((counter = pop_board(thread->open)) != \
+    EMPTY_QUEUE) && (NODE(&thread->arena, counter)->manhattan \
+    >= __atomic_load_n(&thread->hda->incumbent, \
+    __ATOMIC_ACQUIRE))) ;
+
+    if(counter == EMPTY_QUEUE){
+      if(hda_idle(thread)){
+        return NULL ;
+      }
+
+      continue ;
+    }
+
+    current = NODE(&thread->arena, counter) ;
+
+    /* Stale copy, as board was since reached in fewer moves.*/
+    if(closed_moves(&thread->closed, current->board) < \
+    current->moves){
+      continue ;
+    }
+
+    if(check_if_solution(current)){
+      hda_goal(thread, counter) ;
+    }
+
+    else{
+      hda_expand(thread, counter) ;
+
+      /* Other threads need not wait for a full outbox. */
+      if(++expanded % HDA_FLUSH == 0){
+        hda_flush(thread) ;
+      }
+    }
+  }
+
+  return NULL ;
+}
+
+/*
+ * Thread has no board worth expanding: it sends any boards
+ * it holds, then waits for a message (returns FALSE) or for
+ * the work left to reach zero, ie the end, or for an error
+ * (returns TRUE). A message is counted as work until read,
+ * so the work left cannot reach zero while one is on its way.
+ */
+static int hda_idle(Hda_Thread *thread)
+{
+  hda_flush(thread) ;
+
+  if(!mailbox_empty(&thread->mailbox)){
+    return FALSE ;
+  }
+
+  __atomic_sub_fetch(&thread->hda->work, 1, __ATOMIC_SEQ_CST) ;
+
+  while(mailbox_empty(&thread->mailbox)){
+    if((__atomic_load_n(&thread->hda->work, \
+    __ATOMIC_SEQ_CST) == 0) || (__atomic_load_n( \
+    &thread->hda->status, __ATOMIC_ACQUIRE) != SOLVER_OK)){
+      return TRUE ;
+    }
+
+    sched_yield() ;
+  }
+
+  /* Searching again, counted before the message is read. */
+  __atomic_add_fetch(&thread->hda->work, 1, __ATOMIC_SEQ_CST) ;
+
+  return FALSE ;
+}
+
+/* Queues the boards of every message sent to the thread. */
+static void hda_receive(Hda_Thread *thread)
+{
+  Message *message, *next ;
+  long read ;
+  int i ;
+
+  message = take_messages(&thread->mailbox) ;
+  read = 0 ;
+
+  while(message != NULL){
+    for(i = 0 ; i < message->count ; i++){
+      hda_add_board(thread, &message->board[i]) ;
+    }
+
+    next = message->next ;
+    free(message) ;
+    message = next ;
+    read++ ;
+  }
+
+  __atomic_sub_fetch(&thread->hda->work, read, \
+  __ATOMIC_SEQ_CST) ;
+
+  return ;
+}
+
+/*
+ * Adds a board the thread owns to its arena and open list,
+ * unless it has already been reached in as few moves. A
+ * board reached in fewer moves than before is queued again.
+ */
+static void hda_add_board(Hda_Thread *thread, Puzzle *board)
+{
+  int best, place, status ;
+
+  /*
+   * A thread can run ahead of the others, deeper than any
+   * solution (see F_LIMIT), so such boards are never kept.
+   */
+  if((board->manhattan >= F_LIMIT) || (board->manhattan >= \
+  __atomic_load_n(&thread->hda->incumbent, __ATOMIC_ACQUIRE))){
+    return ;
+  }
+
+  best = closed_moves(&thread->closed, board->board) ;
+
+  if((best != CLOSED_NONE) && (best <= board->moves)){
+    return ;
+  }
+
+  status = set_closed(&thread->closed, board->board, \
+  board->moves) ;
+
+  if((status == SOLVER_OK) && ((place = \
+  allocate_space(&thread->arena, board)) == ARENA_FULL)){
+    status = SOLVER_MEMORY_ERROR ;
+  }
+
+  if(status == SOLVER_OK){
+    status = push_board(thread->open, place, board->manhattan, \
+    board->moves) ;
+  }
+
+  if(status != SOLVER_OK){
+    hda_fail(thread->hda, status) ;
+  }
+
+  return ;
+}
+
+/* Creates each child of the board, for the thread owning it.*/
+static void hda_expand(Hda_Thread *thread, int counter)
+{
+  Puzzle children[MAX_CHILDREN] ;
+  int i, owner, threads, num_children ;
+
+  threads = thread->hda->threads ;
+
+  if(counter > (INT_MAX - thread->id) / threads){
+    hda_fail(thread->hda, SOLVER_ARENA_ERROR) ;
+    return ;
+  }
+
+  thread->stats.expanded++ ;
+
+  num_children = generate_children(NODE(&thread->arena, \
+  counter), HDA_PARENT(counter, thread->id, threads), \
+  children, thread->hda->heuristic, &thread->stats) ;
+
+#ifdef MANHATTAN_DEBUG
+  if((i = check_children(children, num_children, \
+  thread->hda->heuristic)) != SOLVER_OK){
+    hda_fail(thread->hda, i) ;
+    return ;
+  }
+#endif
+
+  for(i = 0 ; i < num_children ; i++){
+    owner = HDA_OWNER(children[i].board, threads) ;
+
+    if(owner == thread->id){
+      hda_add_board(thread, &children[i]) ;
+    }
+
+    else{
+      hda_send(thread, owner, &children[i]) ;
+    }
+  }
+
+  return ;
+}
+
+/* Adds child to the outbox for its owner, sent once full. */
+static void hda_send(Hda_Thread *thread, int owner, \
+Puzzle *child)
+{
+  Message *message ;
+
+  if(thread->outbox[owner] == NULL){
+    thread->outbox[owner] = (Message *)malloc(sizeof(Message)) ;
+
+    if(thread->outbox[owner] == NULL){
+      hda_fail(thread->hda, SOLVER_MEMORY_ERROR) ;
+      return ;
+    }
+
+    thread->outbox[owner]->count = 0 ;
+  }
+
+  message = thread->outbox[owner] ;
+
+  message->board[message->count++] = *child ;
+
+  if(message->count == MESSAGE_BOARDS){
+    hda_post(thread, owner) ;
+  }
+
+  return ;
+}
+
+/* Sends the outbox for owner, counted as work until read. */
+static void hda_post(Hda_Thread *thread, int owner)
+{
+  __atomic_add_fetch(&thread->hda->work, 1, __ATOMIC_SEQ_CST) ;
+
+  post_message(&thread->hda->thread[owner].mailbox, \
+  thread->outbox[owner]) ;
+
+  thread->outbox[owner] = NULL ;
+
+  return ;
+}
+
+/* Sends every outbox that holds a board. */
+static void hda_flush(Hda_Thread *thread)
+{
+  int owner ;
+
+  for(owner = 0 ; owner < thread->hda->threads ; owner++){
+    if(thread->outbox[owner] != NULL){
+      hda_post(thread, owner) ;
+    }
+  }
+
+  return ;
+}
+
+/* Keeps the solution, if it is better than the incumbent. */
+static void hda_goal(Hda_Thread *thread, int counter)
+{
+  Hda *hda ;
+  int moves ;
+
+  hda = thread->hda ;
+  moves = NODE(&thread->arena, counter)->moves ;
+
+  pthread_mutex_lock(&hda->lock) ;
+
+  if(moves < hda->incumbent){
+    hda->goal_thread = thread->id ;
+    hda->goal_place = counter ;
+
+    __atomic_store_n(&hda->incumbent, moves, __ATOMIC_RELEASE) ;
+  }
+
+  pthread_mutex_unlock(&hda->lock) ;
+
+  return ;
+}
+
+/*
+ * Follows the parents of the solution back to the start
+ * (across the arenas of every thread), then adds the path
+ * to the arena, after the starting board.
+ */
+static int hda_path(Hda *hda, Arena *arena, int *solution)
+{
+  Puzzle path[G_LIMIT], *board ;
+  int i, counter, parent ;
+
+  board = NODE(&hda->thread[hda->goal_thread].arena, \
+  hda->goal_place) ;
+
+  for(i = hda->incumbent ; i > 0 ; i--){
+    path[i] = *board ;
+    parent = board->parent ;
+
+    board = NODE(&hda->thread[HDA_THREAD(parent, \
+    hda->threads)].arena, HDA_PLACE(parent, hda->threads)) ;
+  }
+
+  counter = 0 ;
+
+  for(i = 1 ; i <= hda->incumbent ; i++){
+    path[i].parent = counter ;
+
+    if((counter = allocate_space(arena, &path[i])) == \
+    ARENA_FULL){
+      return SOLVER_MEMORY_ERROR ;
+    }
+  }
+
+  *solution = counter ;
+
+  return SOLVER_OK ;
+}
+
+/*
+ * Iterative deepening A*: a depth first search that stops at
+ * any board with f over the bound, repeated with the bound
+ * raised to the smallest f that went over it. Only the path
+ * to the current board is kept, so once the solution is
+ * found that path is added to the arena to be displayed.
+ */
+static int ida_star(Arena *arena, Heuristic *heuristic, \
+Search_Stats *stats, int *solution)
+{
+  Puzzle board, child ;
+  int path[IDA_DEPTH_LIMIT] ;
+  int i, bound, next, counter ;
+
+  board = *NODE(arena, 0) ;
+  bound = board.manhattan ;
+
+  while((next = ida_search(&board, bound, path, heuristic, \
+  stats)) != IDA_FOUND){
+    if(next == IDA_TOO_DEEP){
+      return SOLVER_DEPTH_ERROR ;
+    }
+
+    bound = next ;
+  }
+
+  /*
+   * No heuristic ever over-estimates, so solution is found
+   * as soon as the bound reaches its number of moves.
+   */
+  counter = 0 ;
+
+  for(i = 0 ; i < bound ; i++){
+    make_move(NODE(arena, counter), &child, counter, path[i], \
+    heuristic) ;
+
+    if((counter = allocate_space(arena, &child)) == ARENA_FULL){
+      return SOLVER_MEMORY_ERROR ;
+    }
+  }
+
+  *solution = counter ;
+
+  return SOLVER_OK ;
+}
+
+/*
+ * Searches below board (in place) for the solution, up to
+ * the bound. Returns IDA_FOUND, with the tile moved at each
+ * step in path, IDA_TOO_DEEP, or else the smallest f over
+ * the bound.
+ */
+static int ida_search(Puzzle *board, int bound, int *path, \
+Heuristic *heuristic, Search_Stats *stats)
+{
+  Puzzle current ;
+  int i, tile, next, min_f ;
+
+  if(board->manhattan > bound){
+    return board->manhattan ;
+  }
+
+  if(check_if_solution(board)){
+    return IDA_FOUND ;
+  }
+
+  if(board->moves == IDA_DEPTH_LIMIT){
+    return IDA_TOO_DEEP ;
+  }
+
+  stats->expanded++ ;
+
+  /* Kept, so that each move can be undone after search. */
+  current = *board ;
+  min_f = IDA_NO_BOUND ;
+
+  for(i = 0 ; i < neighbour_count[current.blank] ; i++){
+    tile = neighbour[current.blank][i] ;
+
+    /* As generate_children, never undo the last move. */
+    if(tile == current.last_blank){
+      stats->pruned++ ;
+    }
+
+    else{
+      stats->generated++ ;
+
+      path[board->moves] = tile ;
+
+      /* Board is changed in place, then copied back. */
+      make_move(&current, board, current.parent, tile, \
+      heuristic) ;
+
+      next = ida_search(board, bound, path, heuristic, stats) ;
+
+      *board = current ;
+
+      if((next == IDA_FOUND) || (next == IDA_TOO_DEEP)){
+        return next ;
+      }
+
+      if(next < min_f){
+        min_f = next ;
+      }
+    }
+  }
+
+  return min_f ;
+}
+
+/*
+ * Heuristics named in the list, eg "lc,id", or 0 if any is
+ * not a heuristic. The list is only read, a name at a time.
+ */
+int heuristic_from_names(const char *names)
+{
+  const char *name ;
+  size_t length ;
+  int heuristic ;
+
+  heuristic = 0 ;
+
+  for(name = names ; ; name += length + 1){
+    length = strcspn(name, NAME_SEPARATOR) ;
+
+    if(NAME_IS(name, length, MANHATTAN_NAME)){
+      heuristic |= MANHATTAN_HEURISTIC ;
+    }
+
+    else if(NAME_IS(name, length, CONFLICT_NAME)){
+      heuristic |= CONFLICT_HEURISTIC ;
+    }
+
+    else if(NAME_IS(name, length, INVERSION_NAME)){
+      heuristic |= INVERSION_HEURISTIC ;
+    }
+
+    else if(NAME_IS(name, length, WALKING_NAME)){
+      heuristic |= WALKING_HEURISTIC ;
+    }
+
+    /* Empty names, as between two commas, are skipped. */
+    else if(length != 0){
+      return 0 ;
+    }
+
+    if(name[length] == '\0'){
+      return heuristic ;
+    }
+  }
+}
+
+/*
+ * Message of each status, written to message (size chars),
+ * for the caller to print. Those of a file that cannot be
+ * used give its name (failed), up to the comma of a list.
+ */
+char *solver_message(int status, const char *failed, \
+char *message, size_t size)
+{
+  char name[FILENAME_MAX] ;
+  const char *end ;
+  size_t length ;
+
+  if(failed == NULL){
+    failed = "" ;
+  }
+
+  /* Name of a pattern database ends at the comma, if any. */
+  if((status >= SOLVER_PDB_FILE_ERROR) && \
+  (status <= SOLVER_PDB_WRITE_ERROR) && \
+  ((end = strchr(failed, PDB_SEPARATOR)) != NULL)){
+    length = (size_t)(end - failed) ;
+  }
+
+  else{
+    length = strlen(failed) ;
+  }
+
+  if(length >= FILENAME_MAX){
+    length = FILENAME_MAX - 1 ;
+  }
+
+  memcpy(name, failed, length) ;
+  name[length] = '\0' ;
+
+  snprintf(message, size, message_format(status), name) ;
+
+  return message ;
+}
+
+/* Format of the message of each status, see solver_message. */
+static char *message_format(int status)
+{
+  switch(status){
+    case SOLVER_OK : return "" ;
+    case SOLVER_UNSOLVABLE : return UNSOLVABLE_BOARD_ERROR ;
+    case SOLVER_BOARD_ERROR : return BOARD_ERROR ;
+    case SOLVER_GOAL_ERROR : return GOAL_ERROR ;
+    case SOLVER_OPTIONS_ERROR : return OPTIONS_ERROR ;
+    case SOLVER_MEMORY_ERROR : return MEMORY_ERROR ;
+    case SOLVER_THREAD_ERROR : return HDA_THREAD_ERROR ;
+    case SOLVER_PATH_ERROR : return PATH_ERROR ;
+    case SOLVER_QUEUE_ERROR : return EMPTY_QUEUE_ERROR ;
+    case SOLVER_RANGE_ERROR : return QUEUE_RANGE_ERROR ;
+    case SOLVER_DEPTH_ERROR : return IDA_DEPTH_ERROR ;
+    case SOLVER_ARENA_ERROR : return HDA_ARENA_ERROR ;
+    case SOLVER_PDB_FILE_ERROR :
+    case SOLVER_PDB_SIZE_ERROR :
+    case SOLVER_PDB_MAP_ERROR :
+    case SOLVER_PDB_PARTITION_ERROR :
+    case SOLVER_PDB_WRITE_ERROR : return pdb_message(status) ;
+    case SOLVER_PDB_LOSSY_ERROR : return PDB_LOSSY_ERROR ;
+    case SOLVER_WALKING_ERROR : return WALKING_SIZE_ERROR ;
+#ifdef ORACLE_BOARD
+    case SOLVER_ORACLE_FILE_ERROR : return ORACLE_FILE_ERROR ;
+    case SOLVER_ORACLE_SIZE_ERROR : return ORACLE_SIZE_ERROR ;
+    case SOLVER_ORACLE_MAP_ERROR : return ORACLE_MAP_ERROR ;
+#endif
+    case SOLVER_ORACLE_GOAL_ERROR : return ORACLE_GOAL_ERROR ;
+    case SOLVER_ORACLE_TABLE_ERROR : return ORACLE_TABLE_ERROR ;
+    case SOLVER_TABLES_ERROR : return TABLES_ERROR ;
+    case SOLVER_CHECK_ERROR : return MANHATTAN_CHECK_ERROR ;
+    case SOLVER_ESTIMATE_ERROR : return HEURISTIC_CHECK_ERROR ;
+    default : return UNKNOWN_ERROR ;
+  }
+}
@@ -0,0 +1,171 @@
+/*
+ * Header of the solver library for the extension of 8-tile
+ * (see manhattan_solver.c), so that boards can be solved in
+ * another program, with no process per board. Nothing in the
+ * library ever exits or prints: each function returns one of
+ * the status codes below, and solver_message writes the error
+ * message of each into the caller's buffer. The library keeps
+ * no state of its own, so any number of solvers can be used
+ * at once, one per thread.
+ *
+ *   Solver_Options options = SOLVER_DEFAULTS ;
+ *   Solver_Result result = SOLVER_NO_PATH ;
+ *   status = solve("1234 5786", &options, &result) ;
+ *
+ * solves one board, or a solver is made once (create_solver)
+ * and kept warm for every board (solve_board, solve_list).
+ * A file of the options that cannot be used is named to the
+ * caller (failed, of create_solver or of the result), for
+ * solver_message to put in the message. The boards of a
+ * solution are written to the caller's path, if given.
+ * Boards are SOLVER_TILES chars, read across the rows, with
+ * the blank as ' ', and the library is compiled for one
+ * board size (see below), as is the caller. Every name given
+ * here starts with SOLVER_ or Solver, or is one of the
+ * functions of the API.
+ */
+#ifndef MANHATTAN_SOLVER_H
+#define MANHATTAN_SOLVER_H
+
+#include <stddef.h>
+
+/*
+ * Height, width and number of cells of the boards, as the
+ * library was compiled (-DYS=.. -DXS=.., or -DSOLVER_YS=..
+ * -DSOLVER_XS=..), the same for the caller. Defaults to 3x3.
+ */
+#ifndef SOLVER_YS
+#ifdef YS
+#define SOLVER_YS YS
+#else
+#define SOLVER_YS 3
+#endif
+#endif
+#ifndef SOLVER_XS
+#ifdef XS
+#define SOLVER_XS XS
+#else
+#define SOLVER_XS 3
+#endif
+#endif
+#define SOLVER_TILES (SOLVER_YS * SOLVER_XS)
+
+/* Blank tile of a board. */
+#define SOLVER_BLANK ' '
+
+/* Returned by every function of the library. */
+#define SOLVER_OK 0
+#define SOLVER_UNSOLVABLE 1
+#define SOLVER_BOARD_ERROR 2
+#define SOLVER_GOAL_ERROR 3
+#define SOLVER_OPTIONS_ERROR 4
+#define SOLVER_MEMORY_ERROR 5
+#define SOLVER_THREAD_ERROR 6
+#define SOLVER_PATH_ERROR 7
+#define SOLVER_QUEUE_ERROR 8
+#define SOLVER_RANGE_ERROR 9
+#define SOLVER_DEPTH_ERROR 10
+#define SOLVER_ARENA_ERROR 11
+#define SOLVER_PDB_FILE_ERROR 12
+#define SOLVER_PDB_SIZE_ERROR 13
+#define SOLVER_PDB_MAP_ERROR 14
+#define SOLVER_PDB_PARTITION_ERROR 15
+#define SOLVER_PDB_LOSSY_ERROR 16
+#define SOLVER_PDB_WRITE_ERROR 17
+#define SOLVER_WALKING_ERROR 18
+#define SOLVER_ORACLE_FILE_ERROR 19
+#define SOLVER_ORACLE_SIZE_ERROR 20
+#define SOLVER_ORACLE_MAP_ERROR 21
+#define SOLVER_ORACLE_GOAL_ERROR 22
+#define SOLVER_ORACLE_TABLE_ERROR 23
+#define SOLVER_TABLES_ERROR 24
+#define SOLVER_CHECK_ERROR 25
+#define SOLVER_ESTIMATE_ERROR 26
+
+/* Search used to solve the board. */
+enum solver_engine {SOLVER_A_STAR, SOLVER_IDA_STAR, \
+SOLVER_ORACLE, SOLVER_HDA_STAR} ;
+typedef enum solver_engine Solver_Engine ;
+
+/* Heuristics that can be chosen, as bits, so combined. */
+#define SOLVER_MANHATTAN 1
+#define SOLVER_CONFLICT 2
+#define SOLVER_INVERSION 4
+#define SOLVER_PDB 8
+#define SOLVER_WALKING 16
+
+/* Solver_Stats: counts kept by the search, for the user. */
+struct solver_stats{
+  long expanded ;
+  long generated ;
+  long pruned ;
+} ;
+typedef struct solver_stats Solver_Stats ;
+
+/* Solver: everything kept between boards, see the library. */
+typedef struct solver Solver ;
+
+/*
+ * Solver_Options: how to search. Goal is a board (NULL for
+ * tiles in order, blank last), pdb_files a list of pattern
+ * databases separated by commas (left as they are), and
+ * threads those used by the parallel A*, or for a list. The
+ * library never changes them.
+ */
+struct solver_options{
+  Solver_Engine search ;
+  int heuristic ;
+  char *goal ;
+  char *pdb_files ;
+  char *oracle_file ;
+  int threads ;
+} ;
+typedef struct solver_options Solver_Options ;
+
+#define SOLVER_DEFAULTS {SOLVER_A_STAR, SOLVER_MANHATTAN, NULL, \
+NULL, NULL, 1}
+
+/*
+ * Solver_Result: moves of the solution, and the work done.
+ * Path (owned by the caller, or NULL) has room for path_size
+ * boards, and is filled with each board from the start. If
+ * solve cannot use a file of the options, failed points at
+ * its name there (a pattern database's ends at the comma).
+ */
+struct solver_result{
+  int moves ;
+  Solver_Stats stats ;
+  char *path ;
+  int path_size ;
+  const char *failed ;
+} ;
+typedef struct solver_result Solver_Result ;
+
+#define SOLVER_NO_PATH {0, {0, 0, 0}, NULL, 0, NULL}
+
+/*
+ * Solver_Board: one board of a list, and its result. Boards
+ * with any status but SOLVER_OK are left as they are.
+ */
+struct solver_board{
+  char board[SOLVER_TILES] ;
+  int status ;
+  int moves ;
+  Solver_Stats stats ;
+} ;
+typedef struct solver_board Solver_Board ;
+
+int create_solver(Solver **solver, const Solver_Options *options, \
+const char **failed) ;
+int solve_board(Solver *solver, char *board, \
+Solver_Result *result) ;
+int solve_list(Solver *solver, Solver_Board *boards, \
+int count) ;
+void free_solver(Solver *solver) ;
+int solve(char *board, const Solver_Options *options, \
+Solver_Result *result) ;
+int heuristic_from_names(const char *names) ;
+char *solver_message(int status, const char *failed, \
+char *message, size_t size) ;
+
+#endif
@@ -0,0 +1,341 @@
+/*
+ * Header including the walking distance heuristic for the
+ * extension of 8-tile. Looking only at the rows, a board is
+ * how many tiles of each goal row are in each row, and a move
+ * up or down takes one tile from the row next to the blank's
+ * into the blank's row. The fewest such moves to the goal's
+ * counts, plus the same for the columns, never over-estimates
+ * and is never less than the Manhattan distance (tiles in one
+ * row that belong in the same row all have to pass the blank).
+ * Every count that can be reached is found once, when the
+ * goal is known, by a BFS back from it (24964 for the rows of
+ * the 15-puzzle), with the count each move leads to, so a
+ * child's is a single look up.
+ */
+#include <stdlib.h>
+#include <limits.h>
+
+#define WALKING_SIZE_ERROR "\nERROR: Walking distance is not " \
+"available for this board size.\n\n"
+
+/* Blank moves to the line before, or after, its own. */
+#define WALKING_BACK 0
+#define WALKING_ON 1
+#define WALKING_WAYS 2
+
+/* No such count, or no such move. */
+#define WALKING_NONE -1
+
+/* Initial number of counts, and of slots (a power of 2). */
+#define WALKING_START 1024
+
+/* Fibonacci hashing, ie 2^64 / golden ratio. */
+#define WALKING_MULTIPLIER (((Packed)0x9E3779B9UL << 32) | \
+0x7F4A7C15UL)
+#define WALKING_SLOT(code, mask) \
+((unsigned long)(((code) * WALKING_MULTIPLIER) >> 32) & (mask))
+
+/* Tiles of group g in line l, of code in table t. */
+#define WALKING_COUNT(t, code, l, g) ((int)(((code) >> \
+((((l) * (t)->lines) + (g)) * (t)->bits)) & \
+((1 << (t)->bits) - 1)))
+#define WALKING_UNIT(t, l, g) \
+((Packed)1 << ((((l) * (t)->lines) + (g)) * (t)->bits))
+
+/* Count reached from state as the blank takes a tile. */
+#define WALKING_LINK(t, state, way, group) ((t)->link[((((state) \
+* WALKING_WAYS) + (way)) * (t)->lines) + (group)])
+
+/*
+ * Walking_Table: every count for one direction (the rows, if
+ * rows, or else the columns), as lines of width cells, each
+ * count taking bits in a code. Moves is the fewest to the
+ * goal's counts, and slot the index (plus one) of each code,
+ * by its hash.
+ */
+struct walking_table{
+  int rows ;
+  int lines ;
+  int width ;
+  int bits ;
+  int states ;
+  int size ;
+  Packed *code ;
+  unsigned char *moves ;
+  short *link ;
+  int *slot ;
+  unsigned long mask ;
+} ;
+typedef struct walking_table Walking_Table ;
+
+/* Walking: tables of the rows and of the columns. */
+struct walking{
+  Walking_Table row ;
+  Walking_Table column ;
+} ;
+typedef struct walking Walking ;
+
+INTERNAL int create_walking(Walking **walking, int blank) ;
+INTERNAL int make_walking(Walking_Table *table, int rows, \
+int blank) ;
+INTERNAL int walking_find(Walking_Table *table, Packed code) ;
+INTERNAL int walking_add(Walking_Table *table, Packed code, \
+int moves, int *index) ;
+INTERNAL int grow_walking(Walking_Table *table) ;
+INTERNAL int walking_state(Walking_Table *table, Packed board, \
+int blank) ;
+INTERNAL void free_walking(Walking *walking) ;
+
+
+/* Tables for a goal with the blank in cell blank. */
+INTERNAL int create_walking(Walking **walking, int blank)
+{
+  int status ;
+
+  if((*walking = (Walking *)calloc(1, sizeof(Walking))) == NULL){
+    return SOLVER_MEMORY_ERROR ;
+  }
+
+  status = make_walking(&(*walking)->row, 1, blank / XS) ;
+
+  if(status == SOLVER_OK){
+    status = make_walking(&(*walking)->column, 0, blank % XS) ;
+  }
+
+  if(status != SOLVER_OK){
+    free_walking(*walking) ;
+    *walking = NULL ;
+  }
+
+  return status ;
+}
+
+/*
+ * BFS back from the goal's counts (each line full of its own
+ * group, but the blank's line), a count at a time in the
+ * order they are added.
+ */
+INTERNAL int make_walking(Walking_Table *table, int rows, \
+int blank)
+{
+  Packed code, next ;
+  int i, l, g, line, lines, width, way, state, sum, status ;
+
+  lines = rows ? YS : XS ;
+  width = rows ? XS : YS ;
+
+  table->rows = rows ;
+  table->lines = lines ;
+  table->width = width ;
+
+  for(table->bits = 1 ; (1 << table->bits) <= width ; \
+  table->bits++) ;
+
+  table->states = table->size = 0 ;
+  table->code = NULL ;
+  table->moves = NULL ;
+  table->link = NULL ;
+  table->slot = NULL ;
+
+  if(lines * lines * table->bits > (int)(8 * sizeof(Packed))){
+    return SOLVER_WALKING_ERROR ;
+  }
+
+  code = 0 ;
+
+  for(l = 0 ; l < lines ; l++){
+    code += WALKING_UNIT(table, l, l) * \
+    (Packed)(width - (l == blank)) ;
+  }
+
+  if((status = walking_add(table, code, 0, &i)) != SOLVER_OK){
+    return status ;
+  }
+
+  for(state = 0 ; state < table->states ; state++){
+    code = table->code[state] ;
+
+    /* Blank's line is the one short of a tile. */
+    for(line = 0 ; line < lines ; line++){
+      for(g = sum = 0 ; g < lines ; g++){
+        sum += WALKING_COUNT(table, code, line, g) ;
+      }
+
+      if(sum < width){
+        break ;
+      }
+    }
+
+    for(way = 0 ; way < WALKING_WAYS ; way++){
+      l = (way == WALKING_BACK) ? (line - 1) : (line + 1) ;
+
+      for(g = 0 ; g < lines ; g++){
+        WALKING_LINK(table, state, way, g) = WALKING_NONE ;
+
+        if((l >= 0) && (l < lines) && \
+        (WALKING_COUNT(table, code, l, g) > 0)){
+          next = code - WALKING_UNIT(table, l, g) + \
+          WALKING_UNIT(table, line, g) ;
+
+          if(((i = walking_find(table, next)) == WALKING_NONE) \
+          && ((status = walking_add(table, next, \
+          table->moves[state] + 1, &i)) != SOLVER_OK)){
+            return status ;
+          }
+
+          WALKING_LINK(table, state, way, g) = (short)i ;
+        }
+      }
+    }
+  }
+
+  return SOLVER_OK ;
+}
+
+/* Index of the count code, or WALKING_NONE if not added. */
+INTERNAL int walking_find(Walking_Table *table, Packed code)
+{
+  unsigned long i ;
+
+  for(i = WALKING_SLOT(code, table->mask) ; \
+  table->slot[i] != 0 ; i = (i + 1) & table->mask){
+    if(table->code[table->slot[i] - 1] == code){
+      return table->slot[i] - 1 ;
+    }
+  }
+
+  return WALKING_NONE ;
+}
+
+/* Adds code, moves from the goal, and gives its index. */
+INTERNAL int walking_add(Walking_Table *table, Packed code, \
+int moves, int *index)
+{
+  unsigned long i ;
+  int status ;
+
+  if(table->states == SHRT_MAX){
+    return SOLVER_WALKING_ERROR ;
+  }
+
+  if((table->states == table->size) && \
+  ((status = grow_walking(table)) != SOLVER_OK)){
+    return status ;
+  }
+
+  table->code[table->states] = code ;
+  table->moves[table->states] = (unsigned char)moves ;
+
+  for(i = WALKING_SLOT(code, table->mask) ; \
+  table->slot[i] != 0 ; i = (i + 1) & table->mask) ;
+
+  table->slot[i] = ++table->states ;
+
+  *index = table->states - 1 ;
+
+  return SOLVER_OK ;
+}
+
+/*
+ * Doubles the counts held, and rehashes into twice as many.
+ * Each array is only replaced once grown, so the table can
+ * still be freed if one cannot be.
+ */
+INTERNAL int grow_walking(Walking_Table *table)
+{
+  Packed *code ;
+  unsigned char *moves ;
+  short *link ;
+  unsigned long i ;
+  int state, size ;
+
+  size = (table->size == 0) ? WALKING_START : (2 * table->size) ;
+
+  if((code = (Packed *)realloc(table->code, size * \
+  sizeof(Packed))) == NULL){
+    return SOLVER_MEMORY_ERROR ;
+  }
+
+  table->code = code ;
+
+  if((moves = (unsigned char *)realloc(table->moves, size * \
+  sizeof(unsigned char))) == NULL){
+    return SOLVER_MEMORY_ERROR ;
+  }
+
+  table->moves = moves ;
+
+  if((link = (short *)realloc(table->link, size * \
+  WALKING_WAYS * table->lines * sizeof(short))) == NULL){
+    return SOLVER_MEMORY_ERROR ;
+  }
+
+  table->link = link ;
+
+  free(table->slot) ;
+
+  table->slot = (int *)calloc(2 * size, sizeof(int)) ;
+
+  if(table->slot == NULL){
+    return SOLVER_MEMORY_ERROR ;
+  }
+
+  table->size = size ;
+  table->mask = (2 * size) - 1 ;
+
+  for(state = 0 ; state < table->states ; state++){
+    for(i = WALKING_SLOT(table->code[state], table->mask) ; \
+    table->slot[i] != 0 ; i = (i + 1) & table->mask) ;
+
+    table->slot[i] = state + 1 ;
+  }
+
+  return SOLVER_OK ;
+}
+
+/* Index of the counts of board. Only done for the start. */
+INTERNAL int walking_state(Walking_Table *table, Packed board, \
+int blank)
+{
+  Packed code ;
+  int cell, tile ;
+
+  code = 0 ;
+
+  for(cell = 0 ; cell < NUM_TILES ; cell++){
+    tile = CELL(board, cell) ;
+
+    if(cell == blank){
+      continue ;
+    }
+
+    if(table->rows){
+      code += WALKING_UNIT(table, cell / XS, goal_y[tile]) ;
+    }
+
+    else{
+      code += WALKING_UNIT(table, cell % XS, goal_x[tile]) ;
+    }
+  }
+
+  return walking_find(table, code) ;
+}
+
+INTERNAL void free_walking(Walking *walking)
+{
+  Walking_Table *table ;
+  int i ;
+
+  for(i = 0 ; i < 2 ; i++){
+    table = (i == 0) ? &walking->row : &walking->column ;
+
+    free(table->code) ;
+    free(table->moves) ;
+    free(table->link) ;
+    free(table->slot) ;
+  }
+
+  free(walking) ;
+
+  return ;
+}